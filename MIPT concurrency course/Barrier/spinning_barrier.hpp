@@ -0,0 +1,70 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/util/spin_wait.hpp>
+
+#include <cstdint>
+
+namespace solutions {
+
+// Sense-reversing barrier: drop-in replacement for CyclicBarrier
+
+// Participants count arrivals with a single atomic RMW and wait for
+// the phase word to flip. Waiters spin for a while before they park,
+// so short phases do not pay for sleeping and waking up
+
+class SpinningBarrier {
+ public:
+  static const size_t kDefaultSpinLimit = 1000;
+
+  explicit SpinningBarrier(size_t participants,
+                           size_t spin_limit = kDefaultSpinLimit)
+      : participants_(participants), spin_limit_(spin_limit) {
+  }
+
+  // Blocks until all participants have invoked Arrive()
+  void Arrive() {
+    // Phase cannot flip before this thread arrives
+    uint32_t phase = phase_.load();
+
+    if (arrived_.fetch_add(1) + 1 == participants_) {
+      // Reset before release: next phase arrivals see a fresh counter
+      arrived_.store(0);
+      phase_.fetch_add(1);
+      if (sleepers_.load() > 0) {
+        phase_.FutexWakeAll();
+      }
+      return;
+    }
+
+    AwaitPhaseChange(phase);
+  }
+
+ private:
+  void AwaitPhaseChange(uint32_t phase) {
+    twist::util::SpinWait spin_wait;
+    for (size_t i = 0; i < spin_limit_; ++i) {
+      if (phase_.load() != phase) {
+        return;
+      }
+      spin_wait();
+    }
+
+    sleepers_.fetch_add(1);
+    // Re-check after announcing ourselves, pairs with Arrive
+    while (phase_.load() == phase) {
+      phase_.FutexWait(phase);
+    }
+    sleepers_.fetch_sub(1);
+  }
+
+ private:
+  const size_t participants_;
+  const size_t spin_limit_;
+
+  twist::stdlike::atomic<size_t> arrived_{0};
+  twist::stdlike::atomic<uint32_t> phase_{0};
+  twist::stdlike::atomic<uint32_t> sleepers_{0};
+};
+
+}  // namespace solutions
@@ -0,0 +1,69 @@
+#include "../cyclic_barrier.hpp"
+#include "../spinning_barrier.hpp"
+#include "../tree_barrier.hpp"
+
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Participants do nothing but Arrive, so a phase costs exactly
+// one pass through the barrier. Phase latency is measured by
+// the first participant between consecutive returns from Arrive
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kThreadCounts[] = {2, 4, 8, 16, 32, 64};
+static const size_t kPhases = 2000;
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+template <class Barrier>
+void Run(const char* name, size_t threads) {
+  Barrier barrier{threads};
+
+  std::vector<uint64_t> latencies;
+  latencies.reserve(kPhases);
+
+  auto start = Clock::now();
+
+  std::vector<twist::stdlike::thread> participants;
+  for (size_t i = 0; i < threads; ++i) {
+    participants.emplace_back([&, i] {
+      auto last = Clock::now();
+      for (size_t phase = 0; phase < kPhases; ++phase) {
+        barrier.Arrive();
+        if (i == 0) {
+          auto now = Clock::now();
+          latencies.push_back((now - last) / std::chrono::nanoseconds(1));
+          last = now;
+        }
+      }
+    });
+  }
+  for (auto& participant : participants) {
+    participant.join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%-15s threads=%-3zu phases/s=%-10.0f phase ns: p50=%-9lu "
+              "p99=%lu\n",
+              name, threads, kPhases / seconds, Percentile(latencies, 0.5),
+              Percentile(latencies, 0.99));
+}
+
+int main() {
+  for (size_t threads : kThreadCounts) {
+    Run<solutions::CyclicBarrier>("CyclicBarrier", threads);
+    Run<solutions::SpinningBarrier>("SpinningBarrier", threads);
+    Run<solutions::TreeBarrier>("TreeBarrier", threads);
+  }
+  return 0;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/util/spin_wait.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace solutions {
+
+// Combining tree barrier for large participant counts
+
+// Participants arrive at leaves with at most fan_in seats each,
+// the last one to arrive at a node carries the arrival up to its parent.
+// No counter is shared by more than fan_in threads
+
+// Waiters spin on the phase word before they park, as in SpinningBarrier
+
+class TreeBarrier {
+  static const size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Node {
+    twist::stdlike::atomic<size_t> arrived{0};
+    size_t capacity{0};
+    Node* parent{nullptr};
+  };
+
+ public:
+  static const size_t kDefaultFanIn = 4;
+  static const size_t kDefaultSpinLimit = 1000;
+
+  explicit TreeBarrier(size_t participants, size_t fan_in = kDefaultFanIn,
+                       size_t spin_limit = kDefaultSpinLimit)
+      : nodes_(CountNodes(participants, fan_in)), spin_limit_(spin_limit) {
+    assert(participants > 0 && fan_in > 1);
+    BuildTree(participants, fan_in);
+  }
+
+  // Blocks until all participants have invoked Arrive()
+  void Arrive() {
+    // Phase cannot flip before this thread arrives
+    uint32_t phase = phase_.load();
+
+    Node* node = nullptr;
+    bool last = TakeSeat(node);
+
+    // Carry arrival up the tree
+    while (last) {
+      if (node->parent == nullptr) {
+        Release();
+        return;
+      }
+      node = node->parent;
+      last = node->arrived.fetch_add(1) + 1 == node->capacity;
+    }
+
+    AwaitPhaseChange(phase);
+  }
+
+ private:
+  static size_t CountNodes(size_t participants, size_t fan_in) {
+    size_t count = 0;
+    size_t seats = participants;
+    do {
+      seats = (seats + fan_in - 1) / fan_in;
+      count += seats;
+    } while (seats > 1);
+    return count;
+  }
+
+  // Nodes are laid out level by level, leaves first
+  void BuildTree(size_t participants, size_t fan_in) {
+    size_t level_begin = 0;
+    size_t seats = participants;
+    do {
+      size_t level_size = (seats + fan_in - 1) / fan_in;
+      size_t next_level_begin = level_begin + level_size;
+
+      for (size_t i = 0; i < level_size; ++i) {
+        Node& node = nodes_[level_begin + i];
+        node.capacity = std::min(fan_in, seats - i * fan_in);
+        if (level_size > 1) {
+          node.parent = &nodes_[next_level_begin + i / fan_in];
+        }
+      }
+
+      if (level_begin == 0) {
+        leaves_ = level_size;
+      }
+      level_begin = next_level_begin;
+      seats = level_size;
+    } while (seats > 1);
+  }
+
+  // Returns true if this thread is the last to arrive at its leaf
+  bool TakeSeat(Node*& leaf) {
+    // Threads start from different leaves, so they rarely compete
+    static thread_local size_t hint = next_hint.fetch_add(1);
+
+    size_t index = hint % leaves_;
+    while (true) {
+      Node& node = nodes_[index];
+      size_t arrived = node.arrived.load();
+      // Capacities sum up to participant count, so there is always a seat
+      if (arrived < node.capacity &&
+          node.arrived.compare_exchange_weak(arrived, arrived + 1)) {
+        leaf = &node;
+        return arrived + 1 == node.capacity;
+      }
+      if (arrived >= node.capacity) {
+        index = (index + 1) % leaves_;
+      }
+    }
+  }
+
+  void Release() {
+    // Reset before release: next phase arrivals see empty tree
+    for (auto& node : nodes_) {
+      node.arrived.store(0);
+    }
+    phase_.fetch_add(1);
+    if (sleepers_.load() > 0) {
+      phase_.FutexWakeAll();
+    }
+  }
+
+  void AwaitPhaseChange(uint32_t phase) {
+    twist::util::SpinWait spin_wait;
+    for (size_t i = 0; i < spin_limit_; ++i) {
+      if (phase_.load() != phase) {
+        return;
+      }
+      spin_wait();
+    }
+
+    sleepers_.fetch_add(1);
+    // Re-check after announcing ourselves, pairs with Release
+    while (phase_.load() == phase) {
+      phase_.FutexWait(phase);
+    }
+    sleepers_.fetch_sub(1);
+  }
+
+ private:
+  static inline twist::stdlike::atomic<size_t> next_hint{0};
+
+  std::vector<Node> nodes_;
+  size_t leaves_{0};
+  const size_t spin_limit_;
+
+  twist::stdlike::atomic<uint32_t> phase_{0};
+  twist::stdlike::atomic<uint32_t> sleepers_{0};
+};
+
+}  // namespace solutions
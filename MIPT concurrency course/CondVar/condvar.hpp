@@ -2,36 +2,206 @@
 #pragma once
 
 #include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/condition_variable.hpp>
+#include <twist/stdlike/mutex.hpp>
+#include <twist/util/spin_wait.hpp>
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
+#include <utility>
 
 namespace stdlike {
 
+// Every waiter parks on its own node in a FIFO wait list,
+// so NotifyOne wakes exactly one thread
+
+// Timed waiters sleep on an internal condvar
+
 class CondVar {
+  enum State : uint32_t {
+    Waiting = 0,
+    Notified = 1,
+  };
+
+  struct Waiter {
+    explicit Waiter(bool timed = false) : timed(timed) {
+    }
+
+    // Last access of a notifier to the waiter
+    void Release(uint32_t result) {
+      state.store(result);
+      state.FutexWakeOne();
+      released.store(true);
+    }
+
+    // Waiter lives on the stack of its thread: it may return from Wait
+    // only when the notifier is done with it
+    void AwaitRelease() {
+      twist::util::SpinWait spin_wait;
+      while (!released.load()) {
+        spin_wait();
+      }
+    }
+
+    // Futex word, written by notifiers once the waiter leaves the list
+    twist::stdlike::atomic<uint32_t> state{State::Waiting};
+    twist::stdlike::atomic<bool> released{false};
+    const bool timed;
+
+    Waiter* prev{nullptr};
+    Waiter* next{nullptr};
+  };
+
  public:
+  CondVar() = default;
+
+  // Non-copyable
+  CondVar(const CondVar&) = delete;
+  CondVar& operator=(const CondVar&) = delete;
+
   // Mutex - BasicLockable
   // https://en.cppreference.com/w/cpp/named_req/BasicLockable
   template <class Mutex>
   void Wait(Mutex& mutex) {
-    uint32_t old_value = trigger_.load();
+    Waiter waiter;
+    {
+      std::lock_guard guard(lock_);
+      // Enqueue before releasing the mutex: no lost notifications
+      Enqueue(&waiter);
+    }
     mutex.unlock();
-    trigger_.FutexWait(old_value);
+
+    while (waiter.state.load() == State::Waiting) {
+      waiter.state.FutexWait(State::Waiting);
+    }
+    waiter.AwaitRelease();
+
+    mutex.lock();
+  }
+
+  template <class Mutex, class Clock, class Duration>
+  std::cv_status WaitUntil(
+      Mutex& mutex, std::chrono::time_point<Clock, Duration> deadline) {
+    Waiter waiter{/*timed=*/true};
+    {
+      std::lock_guard guard(lock_);
+      // Enqueue before releasing the mutex: no lost notifications
+      Enqueue(&waiter);
+    }
+    mutex.unlock();
+
+    bool notified;
+    {
+      std::unique_lock guard(lock_);
+      notified = timed_wakeup_.wait_until(guard, deadline, [&] {
+        return waiter.state.load() != State::Waiting;
+      });
+      if (!notified) {
+        Unlink(&waiter);
+      }
+    }
+
     mutex.lock();
+    return notified ? std::cv_status::no_timeout : std::cv_status::timeout;
+  }
+
+  template <class Mutex, class Rep, class Period>
+  std::cv_status WaitFor(Mutex& mutex,
+                         std::chrono::duration<Rep, Period> timeout) {
+    return WaitUntil(mutex, std::chrono::steady_clock::now() + timeout);
   }
 
   void NotifyOne() {
-    trigger_.fetch_add(1);
-    trigger_.FutexWakeOne();
+    if (waiters_.load() == 0) {
+      return;  // Fast path
+    }
+
+    Waiter* waiter;
+    {
+      std::lock_guard guard(lock_);
+      waiter = head_;
+      if (waiter == nullptr) {
+        return;
+      }
+      Unlink(waiter);
+      if (waiter->timed) {
+        NotifyTimed(waiter);
+        return;
+      }
+    }
+    Wake(waiter);
   }
 
   void NotifyAll() {
-    trigger_.fetch_add(1);
-    trigger_.FutexWakeAll();
+    Waiter* waiters = DetachAll();
+    while (waiters != nullptr) {
+      // Waiter node dies as soon as it is released
+      Wake(std::exchange(waiters, waiters->next));
+    }
   }
 
  private:
-  twist::stdlike::atomic<uint32_t> trigger_{0};
+  // Returns the list of waiters, timed ones are already notified
+  Waiter* DetachAll() {
+    if (waiters_.load() == 0) {
+      return nullptr;  // Fast path
+    }
+
+    std::lock_guard guard(lock_);
+    Waiter* untimed = nullptr;
+    Waiter** tail = &untimed;
+    while (Waiter* waiter = head_) {
+      Unlink(waiter);
+      if (waiter->timed) {
+        NotifyTimed(waiter);
+      } else {
+        *tail = waiter;
+        tail = &waiter->next;
+      }
+    }
+    return untimed;
+  }
+
+  static void Wake(Waiter* waiter) {
+    waiter->Release(State::Notified);
+  }
+
+  // Guarded by lock_
+  void NotifyTimed(Waiter* waiter) {
+    waiter->state.store(State::Notified);
+    timed_wakeup_.notify_all();
+  }
+
+  // Guarded by lock_
+  void Enqueue(Waiter* waiter) {
+    waiter->prev = tail_;
+    if (tail_ != nullptr) {
+      tail_->next = waiter;
+    } else {
+      head_ = waiter;
+    }
+    tail_ = waiter;
+    waiters_.fetch_add(1);
+  }
+
+  // Guarded by lock_
+  void Unlink(Waiter* waiter) {
+    (waiter->prev != nullptr ? waiter->prev->next : head_) = waiter->next;
+    (waiter->next != nullptr ? waiter->next->prev : tail_) = waiter->prev;
+    waiter->prev = waiter->next = nullptr;
+    waiters_.fetch_sub(1);
+  }
+
+ private:
+  twist::stdlike::mutex lock_;
+  Waiter* head_{nullptr};  // guarded by lock_
+  Waiter* tail_{nullptr};  // guarded by lock_
+  twist::stdlike::atomic<uint32_t> waiters_{0};
+
+  // Timed waits
+  twist::stdlike::condition_variable timed_wakeup_;
 };
 
 }  // namespace stdlike
-
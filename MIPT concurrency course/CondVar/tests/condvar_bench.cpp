@@ -0,0 +1,134 @@
+#include "../condvar.hpp"
+
+#include "../../Mutex/mutex.hpp"
+
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Ping-pong: two threads take turns through a single CondVar
+
+// Broadcast storm: waiters block on a generation counter,
+// every round the coordinator bumps it and calls NotifyAll,
+// the round ends when the last waiter has re-acquired the mutex
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kPingPongRounds = 50000;
+static const size_t kStormWaiterCounts[] = {4, 16, 64};
+static const size_t kStormRounds = 200;
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+static void Report(const char* name, size_t threads, double seconds,
+                   std::vector<uint64_t>& latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%-10s threads=%-3zu ops/s=%-10.0f ns: p50=%-9lu p99=%lu\n",
+              name, threads, latencies.size() / seconds,
+              Percentile(latencies, 0.5), Percentile(latencies, 0.99));
+}
+
+void PingPong() {
+  stdlike::Mutex mutex;
+  stdlike::CondVar turn_changed;
+  size_t turn = 0;  // guarded by mutex
+
+  // Time from handing the turn over to getting it back
+  std::vector<uint64_t> latencies;
+  latencies.reserve(kPingPongRounds);
+
+  auto start = Clock::now();
+
+  twist::stdlike::thread pong([&] {
+    std::unique_lock lock(mutex);
+    for (size_t i = 0; i < kPingPongRounds; ++i) {
+      while (turn % 2 == 0) {
+        turn_changed.Wait(mutex);
+      }
+      ++turn;
+      turn_changed.NotifyOne();
+    }
+  });
+
+  {
+    std::unique_lock lock(mutex);
+    for (size_t i = 0; i < kPingPongRounds; ++i) {
+      auto sent = Clock::now();
+      ++turn;
+      turn_changed.NotifyOne();
+      while (turn % 2 == 1) {
+        turn_changed.Wait(mutex);
+      }
+      latencies.push_back((Clock::now() - sent) / std::chrono::nanoseconds(1));
+    }
+  }
+  pong.join();
+
+  Report("PingPong", 2,
+         std::chrono::duration<double>(Clock::now() - start).count(),
+         latencies);
+}
+
+void Storm(size_t waiters) {
+  stdlike::Mutex mutex;
+  stdlike::CondVar round_started;
+  stdlike::CondVar round_finished;
+  size_t generation = 0;  // guarded by mutex
+  size_t arrived = 0;     // guarded by mutex
+
+  std::vector<twist::stdlike::thread> threads;
+  for (size_t i = 0; i < waiters; ++i) {
+    threads.emplace_back([&] {
+      std::unique_lock lock(mutex);
+      for (size_t seen = 0; seen < kStormRounds; ++seen) {
+        while (generation == seen) {
+          round_started.Wait(mutex);
+        }
+        if (++arrived == waiters) {
+          round_finished.NotifyOne();
+        }
+      }
+    });
+  }
+
+  // Time from the broadcast to the last waiter through the mutex
+  std::vector<uint64_t> latencies;
+  latencies.reserve(kStormRounds);
+
+  auto start = Clock::now();
+  {
+    std::unique_lock lock(mutex);
+    for (size_t i = 0; i < kStormRounds; ++i) {
+      arrived = 0;
+      auto notified = Clock::now();
+      ++generation;
+      round_started.NotifyAll();
+      while (arrived < waiters) {
+        round_finished.Wait(mutex);
+      }
+      latencies.push_back((Clock::now() - notified) /
+                          std::chrono::nanoseconds(1));
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  Report("Storm", waiters,
+         std::chrono::duration<double>(Clock::now() - start).count(),
+         latencies);
+}
+
+int main() {
+  PingPong();
+  for (size_t waiters : kStormWaiterCounts) {
+    Storm(waiters);
+  }
+  return 0;
+}
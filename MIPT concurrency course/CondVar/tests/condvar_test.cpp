@@ -0,0 +1,126 @@
+#include "../condvar.hpp"
+
+#include "../../Mutex/mutex.hpp"
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/thread.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << std::endl;
+    std::abort();
+  }
+}
+
+// Nobody notifies: WaitFor / WaitUntil time out with the mutex re-acquired
+void Timeouts() {
+  stdlike::Mutex mutex;
+  stdlike::CondVar cv;
+
+  std::unique_lock lock(mutex);
+
+  auto start = std::chrono::steady_clock::now();
+  Check(cv.WaitFor(mutex, 50ms) == std::cv_status::timeout,
+        "WaitFor timed out");
+  Check(std::chrono::steady_clock::now() - start >= 50ms,
+        "WaitFor slept the whole timeout");
+
+  auto deadline = std::chrono::steady_clock::now() + 20ms;
+  Check(cv.WaitUntil(mutex, deadline) == std::cv_status::timeout,
+        "WaitUntil timed out");
+  Check(std::chrono::steady_clock::now() >= deadline,
+        "WaitUntil slept until the deadline");
+
+  // Timed out waiters have left the wait list
+  cv.NotifyOne();
+  cv.NotifyAll();
+}
+
+// Notification arrives long before the timeout
+void NotifiedBeforeTimeout() {
+  stdlike::Mutex mutex;
+  stdlike::CondVar cv;
+  bool ready = false;  // guarded by mutex
+
+  twist::stdlike::thread notifier([&] {
+    std::this_thread::sleep_for(10ms);
+    std::lock_guard guard(mutex);
+    ready = true;
+    cv.NotifyOne();
+  });
+
+  {
+    std::unique_lock lock(mutex);
+    while (!ready) {
+      Check(cv.WaitFor(mutex, 10s) == std::cv_status::no_timeout,
+            "WaitFor notified");
+    }
+  }
+  notifier.join();
+}
+
+// NotifyAll wakes plain and timed waiters, every one of them
+// comes back with the mutex held
+void NotifyAllHandOff() {
+  static const size_t kWaiters = 16;
+  static const size_t kRounds = 200;
+
+  for (size_t round = 0; round < kRounds; ++round) {
+    stdlike::Mutex mutex;
+    stdlike::CondVar cv;
+    bool go = false;       // guarded by mutex
+    size_t waiting = 0;    // guarded by mutex
+    size_t inside = 0;     // guarded by mutex
+    size_t woken = 0;      // guarded by mutex
+
+    std::vector<twist::stdlike::thread> waiters;
+    for (size_t i = 0; i < kWaiters; ++i) {
+      waiters.emplace_back([&, i] {
+        std::unique_lock lock(mutex);
+        ++waiting;
+        while (!go) {
+          if (i % 2 == 0) {
+            cv.Wait(mutex);
+          } else {
+            cv.WaitFor(mutex, 10s);
+          }
+        }
+        Check(++inside == 1, "mutex is held by a single waiter");
+        ++woken;
+        --inside;
+      });
+    }
+
+    while (true) {
+      std::lock_guard guard(mutex);
+      if (waiting == kWaiters) {
+        go = true;
+        cv.NotifyAll();
+        break;
+      }
+    }
+
+    // Waiters exit right away: their nodes must not be touched anymore
+    for (auto& waiter : waiters) {
+      waiter.join();
+    }
+    Check(woken == kWaiters, "all waiters woken");
+  }
+}
+
+int main() {
+  Timeouts();
+  NotifiedBeforeTimeout();
+  NotifyAllHandOff();
+  std::cout << "OK" << std::endl;
+  return 0;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace coro::detail {
+
+// Recycles coroutine frames through per-thread free lists
+
+// Frames are bucketed by size (64-byte classes up to 1 KiB),
+// larger frames go straight to operator new
+
+class FrameAllocator {
+  static const size_t kSizeClass = 64;
+  static const size_t kBuckets = 16;
+  static const size_t kMaxCachedPerBucket = 256;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct Cache {
+    FreeBlock* heads[kBuckets] = {};
+    size_t counts[kBuckets] = {};
+
+    ~Cache() {
+      for (size_t i = 0; i < kBuckets; ++i) {
+        while (heads[i] != nullptr) {
+          FreeBlock* block = heads[i];
+          heads[i] = block->next;
+          ::operator delete(block);
+        }
+      }
+    }
+  };
+
+ public:
+  static void* Allocate(size_t size) {
+    size_t bucket = BucketOf(size);
+    if (bucket >= kBuckets) {
+      return ::operator new(size);
+    }
+
+    Cache& cache = LocalCache();
+    if (FreeBlock* block = cache.heads[bucket]) {
+      cache.heads[bucket] = block->next;
+      --cache.counts[bucket];
+      return block;
+    }
+    return ::operator new((bucket + 1) * kSizeClass);
+  }
+
+  // Frame may be freed by a thread other than the one that allocated it
+  static void Deallocate(void* ptr, size_t size) {
+    size_t bucket = BucketOf(size);
+    if (bucket >= kBuckets) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    Cache& cache = LocalCache();
+    if (cache.counts[bucket] == kMaxCachedPerBucket) {
+      ::operator delete(ptr);
+      return;
+    }
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = cache.heads[bucket];
+    cache.heads[bucket] = block;
+    ++cache.counts[bucket];
+  }
+
+ private:
+  static size_t BucketOf(size_t size) {
+    return (size + kSizeClass - 1) / kSizeClass - 1;
+  }
+
+  static Cache& LocalCache() {
+    static thread_local Cache cache;
+    return cache;
+  }
+};
+
+}  // namespace coro::detail
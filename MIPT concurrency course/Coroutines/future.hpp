@@ -0,0 +1,57 @@
+#pragma once
+
+#include <futures/future.hpp>
+
+#include <tp/thread_pool.hpp>
+
+#include <coroutine>
+#include <optional>
+
+namespace stdlike {
+
+// co_await future: suspends coroutine until result is ready
+// Coroutine awaiting from a pool worker is resumed on the same pool,
+// otherwise it is resumed in the thread that fulfills the promise
+
+template <typename T>
+auto operator co_await(Future<T>&& future) {
+  class FutureAwaiter {
+   public:
+    explicit FutureAwaiter(Future<T> future) : future_(std::move(future)) {
+    }
+
+    bool await_ready() noexcept {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      tp::ThreadPool* pool = tp::ThreadPool::Current();
+      // Coroutine may be resumed before Subscribe returns,
+      // do not touch the awaiter afterwards
+      auto future = std::move(future_);
+      std::move(future).Subscribe(
+          [this, handle, pool](Future<T> ready) mutable {
+            ready_.emplace(std::move(ready));
+            if (pool != nullptr) {
+              pool->Submit([handle] {
+                handle.resume();
+              });
+            } else {
+              handle.resume();
+            }
+          });
+    }
+
+    T await_resume() {
+      return ready_->Get();
+    }
+
+   private:
+    Future<T> future_;
+    std::optional<Future<T>> ready_;
+  };
+
+  return FutureAwaiter{std::move(future)};
+}
+
+}  // namespace stdlike
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <tp/thread_pool.hpp>
+
+#include <coroutine>
+
+namespace coro {
+
+// Resumes awaiting coroutine in one of the pool workers
+// Usage:
+//   co_await Schedule(pool);
+
+class ScheduleAwaiter {
+ public:
+  explicit ScheduleAwaiter(tp::ThreadPool& pool) : pool_(pool) {
+  }
+
+  bool await_ready() noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    pool_.Submit([handle] {
+      handle.resume();
+    });
+  }
+
+  void await_resume() noexcept {
+  }
+
+ private:
+  tp::ThreadPool& pool_;
+};
+
+inline ScheduleAwaiter Schedule(tp::ThreadPool& pool) {
+  return ScheduleAwaiter{pool};
+}
+
+}  // namespace coro
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <coro/frame_allocator.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace coro {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct PromiseBase {
+  struct FinalAwaiter {
+    bool await_ready() noexcept {
+      return false;
+    }
+
+    // Symmetric transfer to the awaiting coroutine: no stack growth
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<Promise> handle) noexcept {
+      PromiseBase& promise = handle.promise();
+      if (promise.continuation) {
+        return promise.continuation;
+      }
+      if (promise.detached) {
+        handle.destroy();
+      }
+      return std::noop_coroutine();
+    }
+
+    void await_resume() noexcept {
+    }
+  };
+
+  static void* operator new(size_t size) {
+    return FrameAllocator::Allocate(size);
+  }
+
+  static void operator delete(void* frame, size_t size) {
+    FrameAllocator::Deallocate(frame, size);
+  }
+
+  // Lazy: body starts when task is awaited or detached
+  std::suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  FinalAwaiter final_suspend() noexcept {
+    return {};
+  }
+
+  void unhandled_exception() {
+    exception = std::current_exception();
+  }
+
+  std::coroutine_handle<> continuation;
+  bool detached{false};
+  std::exception_ptr exception;
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+  Task<T> get_return_object() {
+    return Task<T>{std::coroutine_handle<Promise>::from_promise(*this)};
+  }
+
+  void return_value(T result) {
+    value.emplace(std::move(result));
+  }
+
+  T Result() {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    return std::move(*value);
+  }
+
+  std::optional<T> value;
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+  Task<void> get_return_object();
+
+  void return_void() {
+  }
+
+  void Result() {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+};
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Lazy coroutine returning T
+// Usage:
+//   Task<int> Compute(tp::ThreadPool& pool) {
+//     co_await Schedule(pool);
+//     co_return 42;
+//   }
+
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = detail::Promise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  explicit Task(Handle handle) : handle_(handle) {
+  }
+
+  // Non-copyable
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  // Movable
+  Task(Task&& that) : handle_(std::exchange(that.handle_, nullptr)) {
+  }
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      bool await_ready() noexcept {
+        return false;
+      }
+
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<> continuation) noexcept {
+        handle.promise().continuation = continuation;
+        return handle;
+      }
+
+      T await_resume() {
+        return handle.promise().Result();
+      }
+
+      Handle handle;
+    };
+
+    return Awaiter{handle_};
+  }
+
+  // Gives up frame ownership
+  Handle Release() {
+    return std::exchange(handle_, nullptr);
+  }
+
+ private:
+  Handle handle_;
+};
+
+namespace detail {
+
+inline Task<void> Promise<void>::get_return_object() {
+  return Task<void>{std::coroutine_handle<Promise>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Starts task without waiting for it, frame is destroyed on completion
+// Exceptions are discarded, as in tp::ThreadPool
+
+template <typename T>
+void Detach(Task<T> task) {
+  auto handle = task.Release();
+  handle.promise().detached = true;
+  handle.resume();
+}
+
+}  // namespace coro
@@ -0,0 +1,153 @@
+#include <coro/frame_allocator.hpp>
+#include <coro/schedule.hpp>
+#include <coro/task.hpp>
+
+#include <tp/thread_pool.hpp>
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+static void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << std::endl;
+    std::abort();
+  }
+}
+
+coro::Task<int> Value(int value) {
+  co_return value;
+}
+
+coro::Task<int> Fail() {
+  throw std::runtime_error("Fail");
+  co_return 0;
+}
+
+coro::Task<int> Sum(int count) {
+  int sum = 0;
+  for (int i = 0; i < count; ++i) {
+    sum += co_await Value(i);
+  }
+  co_return sum;
+}
+
+// Awaiting tasks that complete synchronously: values and exceptions
+void Await() {
+  bool done = false;
+  auto root = [&]() -> coro::Task<> {
+    Check(co_await Value(42) == 42, "co_await value");
+
+    bool caught = false;
+    try {
+      co_await Fail();
+    } catch (const std::runtime_error&) {
+      caught = true;
+    }
+    Check(caught, "co_await rethrows");
+
+    Check(co_await Sum(1000) == 499500, "co_await in a loop");
+    done = true;
+  };
+  coro::Detach(root());
+  Check(done, "synchronous tasks complete inline");
+}
+
+// Lazy task that is never started only frees its frame
+void NeverStarted() {
+  bool started = false;
+  auto task = [&]() -> coro::Task<> {
+    started = true;
+    co_return;
+  }();
+  Check(!started, "task is lazy");
+}
+
+coro::Task<size_t> Leaf(tp::ThreadPool& pool, size_t value) {
+  co_await coro::Schedule(pool);
+  Check(tp::Current() == &pool, "leaf runs in the pool");
+  co_return value;
+}
+
+// Detached roots hop to the pool, fan out to leaves that hop again:
+// frames are allocated in one thread and freed in another all the time
+void Schedule() {
+  static const size_t kRoots = 1000;
+  static const size_t kLeaves = 10;
+
+  twist::stdlike::atomic<size_t> total{0};
+  {
+    tp::ThreadPool pool{4};
+
+    auto root = [&](size_t index) -> coro::Task<> {
+      co_await coro::Schedule(pool);
+      Check(tp::Current() == &pool, "root runs in the pool");
+      size_t sum = 0;
+      for (size_t i = 0; i < kLeaves; ++i) {
+        sum += co_await Leaf(pool, index);
+      }
+      total.fetch_add(sum);
+    };
+
+    for (size_t i = 0; i < kRoots; ++i) {
+      coro::Detach(root(i));
+    }
+
+    pool.WaitIdle();
+    pool.Stop();
+  }
+  // Workers have exited and freed their frame caches
+
+  Check(total.load() == kLeaves * kRoots * (kRoots - 1) / 2, "all tasks");
+}
+
+// Frame allocated by one thread, freed and then reused by another,
+// the allocating thread exits in between
+void CrossThreadFree() {
+  using coro::detail::FrameAllocator;
+
+  static const size_t kFrameSize = 200;
+  static const size_t kFrames = 1000;  // Above the per-bucket cache limit
+
+  std::vector<void*> frames;
+  twist::stdlike::thread allocator([&] {
+    for (size_t i = 0; i < kFrames; ++i) {
+      frames.push_back(FrameAllocator::Allocate(kFrameSize));
+    }
+  });
+  allocator.join();
+
+  twist::stdlike::thread deallocator([&] {
+    for (void* frame : frames) {
+      FrameAllocator::Deallocate(frame, kFrameSize);
+    }
+    // Served from this thread's cache
+    void* frame = FrameAllocator::Allocate(kFrameSize);
+    Check(std::find(frames.begin(), frames.end(), frame) != frames.end(),
+          "freed frame is reused");
+    FrameAllocator::Deallocate(frame, kFrameSize);
+  });
+  deallocator.join();
+
+  // Task created here, destroyed without running in another thread
+  auto task = Value(7);
+  twist::stdlike::thread destroyer([task = std::move(task)]() mutable {
+    auto dead = std::move(task);
+  });
+  destroyer.join();
+}
+
+int main() {
+  Await();
+  NeverStarted();
+  Schedule();
+  CrossThreadFree();
+
+  std::cout << "OK" << std::endl;
+  return 0;
+}
@@ -0,0 +1,33 @@
+#include <fibers/api.hpp>
+
+#include <cassert>
+
+namespace fibers {
+
+namespace {
+
+struct YieldAwaiter : IAwaiter {
+  void AwaitSuspend(Fiber* fiber) override {
+    fiber->Schedule();
+  }
+};
+
+}  // namespace
+
+void Spawn(Scheduler& scheduler, Routine routine) {
+  auto* fiber = new Fiber(scheduler, std::move(routine));
+  fiber->Schedule();
+}
+
+void Spawn(Routine routine) {
+  Fiber* self = Fiber::Self();
+  assert(self != nullptr);
+  Spawn(self->GetScheduler(), std::move(routine));
+}
+
+void Yield() {
+  YieldAwaiter awaiter;
+  Fiber::Self()->Suspend(&awaiter);
+}
+
+}  // namespace fibers
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <fibers/fiber.hpp>
+
+namespace fibers {
+
+// Starts a new fiber in the given scheduler
+void Spawn(Scheduler& scheduler, Routine routine);
+
+// Starts a new fiber in the scheduler of the current fiber
+void Spawn(Routine routine);
+
+// Reschedules the current fiber, letting others run
+void Yield();
+
+}  // namespace fibers
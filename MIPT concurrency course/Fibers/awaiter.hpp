@@ -0,0 +1,18 @@
+#pragma once
+
+namespace fibers {
+
+class Fiber;
+
+// Action performed on behalf of suspended fiber
+
+// Runs in the worker thread after the fiber has switched away,
+// so it may safely hand the fiber to someone who will resume it
+
+struct IAwaiter {
+  virtual ~IAwaiter() = default;
+
+  virtual void AwaitSuspend(Fiber* fiber) = 0;
+};
+
+}  // namespace fibers
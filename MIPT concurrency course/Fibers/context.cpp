@@ -0,0 +1,23 @@
+#include <fibers/context.hpp>
+
+#include <cstdlib>
+
+namespace fibers {
+
+void ExecutionContext::Setup(const Stack& stack, Entry entry) {
+  if (getcontext(&context_) != 0) {
+    std::abort();
+  }
+  context_.uc_stack.ss_sp = stack.Bottom();
+  context_.uc_stack.ss_size = stack.Size();
+  context_.uc_link = nullptr;  // Entry never returns
+  makecontext(&context_, entry, 0);
+}
+
+void ExecutionContext::SwitchTo(ExecutionContext& target) {
+  if (swapcontext(&context_, &target.context_) != 0) {
+    std::abort();
+  }
+}
+
+}  // namespace fibers
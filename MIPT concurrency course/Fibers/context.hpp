@@ -0,0 +1,25 @@
+#pragma once
+
+#include <fibers/stack.hpp>
+
+#include <ucontext.h>
+
+namespace fibers {
+
+// Saved execution context (registers, stack pointer)
+
+class ExecutionContext {
+ public:
+  using Entry = void (*)();
+
+  // Prepares context to run entry on the given stack
+  void Setup(const Stack& stack, Entry entry);
+
+  // Saves current context to this and switches to target
+  void SwitchTo(ExecutionContext& target);
+
+ private:
+  ucontext_t context_;
+};
+
+}  // namespace fibers
@@ -0,0 +1,75 @@
+#include <fibers/fiber.hpp>
+
+#include <cassert>
+#include <cstdlib>
+#include <utility>
+
+#include <twist/util/thread_local.hpp>
+
+namespace fibers {
+
+////////////////////////////////////////////////////////////////////////////////
+
+static twist::util::ThreadLocalPtr<Fiber> current;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Fiber::Fiber(Scheduler& scheduler, Routine routine)
+    : scheduler_(scheduler),
+      routine_(std::move(routine)),
+      stack_(Stack::Allocate()) {
+  context_.Setup(stack_, Trampoline);
+}
+
+void Fiber::Schedule() {
+  scheduler_.Submit([this] {
+    Step();
+  });
+}
+
+void Fiber::Resume() {
+  Schedule();
+}
+
+void Fiber::Suspend(IAwaiter* awaiter) {
+  assert(Self() == this);
+  awaiter_ = awaiter;
+  context_.SwitchTo(worker_context_);
+}
+
+Fiber* Fiber::Self() {
+  return current;
+}
+
+void Fiber::Step() {
+  current = this;
+  worker_context_.SwitchTo(context_);
+  current = nullptr;
+
+  if (completed_) {
+    delete this;
+    return;
+  }
+
+  // Fiber may be resumed and even completed by the time
+  // AwaitSuspend returns, so do not touch it afterwards
+  std::exchange(awaiter_, nullptr)->AwaitSuspend(this);
+}
+
+void Fiber::Trampoline() {
+  Fiber* self = Self();
+
+  try {
+    self->routine_();
+  } catch (...) {
+  }
+  // Destroy captured state while we are still on the fiber stack
+  self->routine_ = Routine{};
+
+  self->completed_ = true;
+  self->context_.SwitchTo(self->worker_context_);
+
+  std::abort();  // Unreachable
+}
+
+}  // namespace fibers
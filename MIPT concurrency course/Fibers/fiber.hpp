@@ -0,0 +1,61 @@
+#pragma once
+
+#include <fibers/awaiter.hpp>
+#include <fibers/context.hpp>
+#include <fibers/stack.hpp>
+
+#include <tp/thread_pool.hpp>
+
+#include <wheels/support/function.hpp>
+
+namespace fibers {
+
+using Routine = wheels::UniqueFunction<void()>;
+using Scheduler = tp::ThreadPool;
+
+// Stackful coroutine scheduled to a thread pool
+
+// Each Step runs fiber on some worker until it suspends or completes,
+// suspended fiber does not occupy a worker
+
+class Fiber {
+ public:
+  Fiber(Scheduler& scheduler, Routine routine);
+
+  // Non-copyable
+  Fiber(const Fiber&) = delete;
+  Fiber& operator=(const Fiber&) = delete;
+
+  // Submits next step to the scheduler
+  void Schedule();
+
+  // Continues suspended fiber, called by whoever awaiter handed it to
+  void Resume();
+
+  // Called from this fiber: switches back to the worker
+  // and lets awaiter decide when to resume
+  void Suspend(IAwaiter* awaiter);
+
+  Scheduler& GetScheduler() {
+    return scheduler_;
+  }
+
+  // Currently running fiber or nullptr
+  static Fiber* Self();
+
+ private:
+  void Step();
+
+  [[noreturn]] static void Trampoline();
+
+ private:
+  Scheduler& scheduler_;
+  Routine routine_;
+  Stack stack_;
+  ExecutionContext context_;
+  ExecutionContext worker_context_;
+  IAwaiter* awaiter_{nullptr};
+  bool completed_{false};
+};
+
+}  // namespace fibers
@@ -0,0 +1,53 @@
+#include <fibers/stack.hpp>
+
+#include <sys/mman.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <utility>
+
+namespace fibers {
+
+Stack Stack::Allocate(size_t size) {
+  size_t total = size + kGuardSize;
+
+  // Pages are committed lazily, so large fiber counts cost
+  // only the memory their stacks actually touch
+  void* start = mmap(nullptr, total, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (start == MAP_FAILED) {
+    std::abort();
+  }
+
+  // Overflow hits the guard page instead of someone else's memory
+  int result = mprotect(start, kGuardSize, PROT_NONE);
+  assert(result == 0);
+  (void)result;
+
+  return Stack(static_cast<char*>(start), total);
+}
+
+Stack::Stack(Stack&& that)
+    : start_(std::exchange(that.start_, nullptr)),
+      size_(std::exchange(that.size_, 0)) {
+}
+
+Stack& Stack::operator=(Stack&& that) {
+  Release();
+  start_ = std::exchange(that.start_, nullptr);
+  size_ = std::exchange(that.size_, 0);
+  return *this;
+}
+
+Stack::~Stack() {
+  Release();
+}
+
+void Stack::Release() {
+  if (start_ != nullptr) {
+    munmap(start_, size_);
+    start_ = nullptr;
+  }
+}
+
+}  // namespace fibers
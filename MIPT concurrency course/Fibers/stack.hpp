@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+namespace fibers {
+
+// mmap-ed stack with a guard page below it
+
+class Stack {
+ public:
+  static const size_t kDefaultSize = 64 * 1024;
+
+  static Stack Allocate(size_t size = kDefaultSize);
+
+  Stack(Stack&& that);
+  Stack& operator=(Stack&& that);
+
+  // Non-copyable
+  Stack(const Stack&) = delete;
+  Stack& operator=(const Stack&) = delete;
+
+  ~Stack();
+
+  // Lowest usable address
+  char* Bottom() const {
+    return start_ + kGuardSize;
+  }
+
+  size_t Size() const {
+    return size_ - kGuardSize;
+  }
+
+ private:
+  static const size_t kGuardSize = 4096;
+
+  Stack(char* start, size_t size) : start_(start), size_(size) {
+  }
+
+  void Release();
+
+ private:
+  char* start_;
+  size_t size_;
+};
+
+}  // namespace fibers
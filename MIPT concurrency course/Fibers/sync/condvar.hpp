@@ -0,0 +1,78 @@
+#pragma once
+
+#include <fibers/awaiter.hpp>
+#include <fibers/fiber.hpp>
+#include <fibers/sync/spinlock.hpp>
+#include <fibers/sync/wait_queue.hpp>
+
+#include <mutex>
+
+namespace fibers {
+
+// Condition variable for fibers: Wait suspends the fiber, not the worker
+
+class CondVar {
+  template <typename Mutex>
+  class WaitAwaiter : public IAwaiter {
+   public:
+    WaitAwaiter(detail::ParkAwaiter& park, Mutex& mutex)
+        : park_(park), mutex_(mutex) {
+    }
+
+    void AwaitSuspend(Fiber* fiber) override {
+      // This awaiter lives on the fiber stack, which may be gone
+      // once the fiber is enqueued and resumed
+      Mutex& mutex = mutex_;
+      // Enqueue before releasing the mutex: no lost notifications
+      park_.AwaitSuspend(fiber);
+      mutex.unlock();
+    }
+
+   private:
+    detail::ParkAwaiter& park_;
+    Mutex& mutex_;
+  };
+
+ public:
+  // Mutex - BasicLockable, e.g. fibers::Mutex
+  template <typename Mutex>
+  void Wait(Mutex& mutex) {
+    std::unique_lock guard(spinlock_);
+
+    detail::WaitNode node;
+    detail::ParkAwaiter park(waiters_, node, guard);
+    WaitAwaiter<Mutex> awaiter(park, mutex);
+    Fiber::Self()->Suspend(&awaiter);
+
+    mutex.lock();
+  }
+
+  void NotifyOne() {
+    std::unique_lock guard(spinlock_);
+    detail::WaitNode* node = waiters_.TryPop();
+    guard.unlock();
+
+    if (node != nullptr) {
+      node->fiber->Resume();
+    }
+  }
+
+  void NotifyAll() {
+    std::unique_lock guard(spinlock_);
+    detail::WaitNode* node = waiters_.PopAll();
+    guard.unlock();
+
+    while (node != nullptr) {
+      // Node dies as soon as its fiber is resumed
+      detail::WaitNode* next = node->next;
+      node->fiber->Resume();
+      node = next;
+    }
+  }
+
+ private:
+  detail::SpinLock spinlock_;
+  detail::WaitQueue waiters_;  // guarded by spinlock_
+};
+
+}  // namespace fibers
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <fibers/awaiter.hpp>
+#include <fibers/fiber.hpp>
+
+#include <futures/future.hpp>
+
+#include <optional>
+
+namespace fibers {
+
+// Fiber-aware Future::Get: suspends the fiber until result is ready
+// Usage:
+//   int value = fibers::Await(promise.MakeFuture());
+
+template <typename T>
+T Await(stdlike::Future<T> future) {
+  class FutureAwaiter : public IAwaiter {
+   public:
+    explicit FutureAwaiter(stdlike::Future<T> future)
+        : future_(std::move(future)) {
+    }
+
+    void AwaitSuspend(Fiber* fiber) override {
+      // Callback may resume the fiber right away, and the fiber
+      // destroys this awaiter, so move everything we need out of it
+      auto future = std::move(future_);
+      auto* ready = &ready_;
+      std::move(future).Subscribe(
+          [fiber, ready](stdlike::Future<T> result) mutable {
+            ready->emplace(std::move(result));
+            fiber->Resume();
+          });
+    }
+
+    T Get() {
+      return ready_->Get();
+    }
+
+   private:
+    stdlike::Future<T> future_;
+    std::optional<stdlike::Future<T>> ready_;
+  };
+
+  FutureAwaiter awaiter(std::move(future));
+  Fiber::Self()->Suspend(&awaiter);
+  return awaiter.Get();
+}
+
+}  // namespace fibers
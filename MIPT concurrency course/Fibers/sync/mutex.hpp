@@ -0,0 +1,65 @@
+#pragma once
+
+#include <fibers/fiber.hpp>
+#include <fibers/sync/spinlock.hpp>
+#include <fibers/sync/wait_queue.hpp>
+
+#include <mutex>
+#include <utility>
+
+namespace fibers {
+
+// Mutex for fibers: contended Lock suspends the fiber, not the worker
+// Must be locked from fiber, may be unlocked from anywhere
+
+class Mutex {
+ public:
+  void Lock() {
+    std::unique_lock guard(spinlock_);
+
+    if (!locked_) {
+      locked_ = true;
+      return;
+    }
+
+    // Unlock hands ownership over to us directly
+    detail::WaitNode node;
+    detail::ParkAwaiter awaiter(waiters_, node, guard);
+    Fiber::Self()->Suspend(&awaiter);
+  }
+
+  bool TryLock() {
+    std::lock_guard guard(spinlock_);
+    return !std::exchange(locked_, true);
+  }
+
+  void Unlock() {
+    std::unique_lock guard(spinlock_);
+
+    detail::WaitNode* next = waiters_.TryPop();
+    if (next == nullptr) {
+      locked_ = false;
+      return;
+    }
+
+    guard.unlock();
+    next->fiber->Resume();
+  }
+
+  // BasicLockable
+
+  void lock() {  // NOLINT
+    Lock();
+  }
+
+  void unlock() {  // NOLINT
+    Unlock();
+  }
+
+ private:
+  detail::SpinLock spinlock_;
+  bool locked_{false};         // guarded by spinlock_
+  detail::WaitQueue waiters_;  // guarded by spinlock_
+};
+
+}  // namespace fibers
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/util/spin_wait.hpp>
+
+namespace fibers::detail {
+
+// Guards short critical sections inside fiber primitives
+
+class SpinLock {
+ public:
+  void Lock() {
+    twist::util::SpinWait spin_wait;
+    while (locked_.exchange(true)) {
+      while (locked_.load()) {
+        spin_wait();
+      }
+    }
+  }
+
+  void Unlock() {
+    locked_.store(false);
+  }
+
+  // BasicLockable
+
+  void lock() {  // NOLINT
+    Lock();
+  }
+
+  void unlock() {  // NOLINT
+    Unlock();
+  }
+
+ private:
+  twist::stdlike::atomic<bool> locked_{false};
+};
+
+}  // namespace fibers::detail
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <fibers/awaiter.hpp>
+#include <fibers/fiber.hpp>
+#include <fibers/sync/spinlock.hpp>
+
+#include <mutex>
+
+namespace fibers::detail {
+
+// Intrusive FIFO of suspended fibers, guarded by external SpinLock
+// Nodes live on the stacks of waiting fibers
+
+struct WaitNode {
+  Fiber* fiber{nullptr};
+  WaitNode* next{nullptr};
+};
+
+class WaitQueue {
+ public:
+  void Push(WaitNode* node) {
+    node->next = nullptr;
+    if (tail_ == nullptr) {
+      head_ = tail_ = node;
+    } else {
+      tail_ = tail_->next = node;
+    }
+  }
+
+  WaitNode* TryPop() {
+    WaitNode* node = head_;
+    if (node != nullptr) {
+      head_ = node->next;
+      if (head_ == nullptr) {
+        tail_ = nullptr;
+      }
+    }
+    return node;
+  }
+
+  // Detaches all nodes, returns list head
+  WaitNode* PopAll() {
+    WaitNode* head = head_;
+    head_ = tail_ = nullptr;
+    return head;
+  }
+
+  bool IsEmpty() const {
+    return head_ == nullptr;
+  }
+
+ private:
+  WaitNode* head_{nullptr};
+  WaitNode* tail_{nullptr};
+};
+
+// Enqueues the fiber and releases the spinlock once it has switched away
+class ParkAwaiter : public IAwaiter {
+ public:
+  ParkAwaiter(WaitQueue& queue, WaitNode& node,
+              std::unique_lock<SpinLock>& guard)
+      : queue_(queue), node_(node), guard_(guard) {
+  }
+
+  void AwaitSuspend(Fiber* fiber) override {
+    node_.fiber = fiber;
+    queue_.Push(&node_);
+    // Fiber may be resumed (and its guard destroyed) as soon as
+    // the spinlock is free, so detach the guard first
+    SpinLock* spinlock = guard_.release();
+    spinlock->Unlock();
+  }
+
+ private:
+  WaitQueue& queue_;
+  WaitNode& node_;
+  std::unique_lock<SpinLock>& guard_;
+};
+
+}  // namespace fibers::detail
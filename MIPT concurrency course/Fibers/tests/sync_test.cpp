@@ -0,0 +1,105 @@
+#include <fibers/api.hpp>
+#include <fibers/sync/condvar.hpp>
+#include <fibers/sync/mutex.hpp>
+
+#include <tp/thread_pool.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+// Fibers ping-pong through Mutex + CondVar on a multi-threaded pool:
+// every wake-up may resume the fiber on another worker while
+// the notifier is still inside Suspend/AwaitSuspend
+
+static const size_t kWorkers = 4;
+static const size_t kPairs = 8;
+static const size_t kRounds = 10000;
+
+void PingPong() {
+  tp::ThreadPool scheduler{kWorkers};
+
+  struct Table {
+    fibers::Mutex mutex;
+    fibers::CondVar turn_changed;
+    size_t turn{0};  // guarded by mutex
+    size_t hits{0};  // guarded by mutex
+  };
+
+  Table tables[kPairs];
+
+  for (auto& table : tables) {
+    for (size_t player = 0; player < 2; ++player) {
+      fibers::Spawn(scheduler, [&table, player] {
+        for (size_t i = 0; i < kRounds; ++i) {
+          std::unique_lock guard(table.mutex);
+          while (table.turn % 2 != player) {
+            table.turn_changed.Wait(table.mutex);
+          }
+          ++table.turn;
+          ++table.hits;
+          table.turn_changed.NotifyOne();
+        }
+      });
+    }
+  }
+
+  scheduler.WaitIdle();
+  scheduler.Stop();
+
+  for (auto& table : tables) {
+    if (table.turn != 2 * kRounds || table.hits != 2 * kRounds) {
+      std::abort();
+    }
+  }
+}
+
+void Contention() {
+  tp::ThreadPool scheduler{kWorkers};
+
+  static const size_t kFibers = 64;
+  static const size_t kIncrements = 1000;
+
+  fibers::Mutex mutex;
+  fibers::CondVar all_done;
+  size_t counter = 0;  // guarded by mutex
+  size_t done = 0;     // guarded by mutex
+
+  for (size_t i = 0; i < kFibers; ++i) {
+    fibers::Spawn(scheduler, [&] {
+      for (size_t j = 0; j < kIncrements; ++j) {
+        std::lock_guard guard(mutex);
+        ++counter;
+        if (j % 16 == 0) {
+          fibers::Yield();  // Hold the mutex across a reschedule
+        }
+      }
+      std::lock_guard guard(mutex);
+      ++done;
+      all_done.NotifyAll();
+    });
+  }
+
+  fibers::Spawn(scheduler, [&] {
+    std::unique_lock guard(mutex);
+    while (done != kFibers) {
+      all_done.Wait(mutex);
+    }
+    if (counter != kFibers * kIncrements) {
+      std::abort();
+    }
+  });
+
+  scheduler.WaitIdle();
+  scheduler.Stop();
+
+  if (counter != kFibers * kIncrements) {
+    std::abort();
+  }
+}
+
+int main() {
+  PingPong();
+  Contention();
+  std::cout << "OK" << std::endl;
+  return 0;
+}
@@ -1,57 +1,176 @@
 #pragma once
 
 #include <cassert>
+#include <exception>
 #include <variant>
-#include <memory>
+#include <optional>
+#include <utility>
 
 #include <twist/stdlike/atomic.hpp>
-#include <twist/stdlike/mutex.hpp>
+
+#include <wheels/support/function.hpp>
 
 namespace stdlike::detail {
 
+template <typename T>
+class ChannelRef;
+
+// One-shot channel shared by Promise and Future
+
+// Lock-free: result is published through a single state word,
+// consumer parks on it only if it comes before the producer
+
 template <typename T>
 class Channel {
+  enum State : uint32_t {
+    Empty = 0,
+    ConsumerWaiting = 1,  // Consumer sleeps in Get
+    Subscribed = 2,       // Callback is set
+    Ready = 3,            // Result is set
+  };
+
  public:
+  // Receives channel with result
+  using Callback = wheels::UniqueFunction<void(ChannelRef<T>)>;
+
   Channel() {
   }
 
   void PutValue(T value) {
-    std::unique_lock guard(mutex_);
     result_.template emplace<1>(std::move(value));
-    guard.unlock();
-    has_result_.store(1);
-    has_result_.FutexWakeAll();
+    Complete();
   }
 
   void PutException(std::exception_ptr ex) {
-    std::unique_lock guard(mutex_);
     result_.template emplace<2>(ex);
-    guard.unlock();
-    has_result_.store(1);
-    has_result_.FutexWakeAll();
+    Complete();
+  }
+
+  // Callback is invoked exactly once: right here if result is already
+  // set, otherwise in the thread that puts the result
+  void Subscribe(Callback callback) {
+    callback_.emplace(std::move(callback));
+
+    uint32_t state = State::Empty;
+    if (!state_.compare_exchange_strong(state, State::Subscribed)) {
+      assert(state == State::Ready);
+      RunCallback();
+    }
   }
 
   T Get() {
-    while (has_result_.load() == 0) {
-      has_result_.FutexWait(0);
+    uint32_t state = State::Empty;
+    state_.compare_exchange_strong(state, State::ConsumerWaiting);
+
+    while (state_.load() != State::Ready) {
+      state_.FutexWait(State::ConsumerWaiting);
     }
 
-    std::lock_guard guard(mutex_);
     if (result_.index() == 1) {
       return std::move(std::get<1>(result_));
     }
     std::rethrow_exception(std::get<2>(result_));
   }
 
+  // Intrusive reference counting, see ChannelRef
+
+  void AddRef() {
+    refs_.fetch_add(1);
+  }
+
+  void ReleaseRef() {
+    if (refs_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
   // Non-copyable
   Channel(const Channel&) = delete;
   Channel& operator=(const Channel&) = delete;
 
  private:
-  twist::stdlike::atomic<uint32_t> has_result_{0};
-  twist::stdlike::mutex mutex_;
+  void Complete() {
+    switch (state_.exchange(State::Ready)) {
+      case State::ConsumerWaiting:
+        state_.FutexWakeOne();
+        break;
+      case State::Subscribed:
+        RunCallback();
+        break;
+      default:
+        break;
+    }
+  }
+
+  void RunCallback() {
+    Callback callback = std::move(*callback_);
+    callback_.reset();
+    callback(ChannelRef<T>::Share(this));
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> state_{State::Empty};
+  twist::stdlike::atomic<uint32_t> refs_{1};
+  // Written before state_ leaves Empty, read after it becomes Ready
   std::variant<std::monostate, T, std::exception_ptr> result_;
+  std::optional<Callback> callback_;
 };
 
-}  // namespace stdlike::detail
+// Owning pointer to Channel: single allocation for channel
+// and its reference counter
+
+template <typename T>
+class ChannelRef {
+ public:
+  static ChannelRef Make() {
+    return ChannelRef(new Channel<T>());  // refs = 1
+  }
+
+  static ChannelRef Share(Channel<T>* channel) {
+    channel->AddRef();
+    return ChannelRef(channel);
+  }
+
+  ChannelRef(const ChannelRef& that) : channel_(that.channel_) {
+    if (channel_ != nullptr) {
+      channel_->AddRef();
+    }
+  }
 
+  ChannelRef& operator=(const ChannelRef& that) {
+    ChannelRef(that).Swap(*this);
+    return *this;
+  }
+
+  ChannelRef(ChannelRef&& that)
+      : channel_(std::exchange(that.channel_, nullptr)) {
+  }
+
+  ChannelRef& operator=(ChannelRef&& that) {
+    ChannelRef(std::move(that)).Swap(*this);
+    return *this;
+  }
+
+  ~ChannelRef() {
+    if (channel_ != nullptr) {
+      channel_->ReleaseRef();
+    }
+  }
+
+  Channel<T>* operator->() const {
+    return channel_;
+  }
+
+ private:
+  explicit ChannelRef(Channel<T>* channel) : channel_(channel) {
+  }
+
+  void Swap(ChannelRef& that) {
+    std::swap(channel_, that.channel_);
+  }
+
+ private:
+  Channel<T>* channel_;
+};
+
+}  // namespace stdlike::detail
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <futures/future.hpp>
+#include <futures/promise.hpp>
+
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <twist/stdlike/atomic.hpp>
+
+namespace stdlike {
+
+namespace detail {
+
+template <typename... Ts>
+class AllCombinator {
+ public:
+  AllCombinator() : remaining_(sizeof...(Ts)) {
+  }
+
+  Future<std::tuple<Ts...>> MakeFuture() {
+    return promise_.MakeFuture();
+  }
+
+  template <size_t Index, typename U>
+  void Set(Future<U> ready) {
+    try {
+      std::get<Index>(values_).emplace(ready.Get());
+    } catch (...) {
+      Fail(std::current_exception());
+      return;
+    }
+
+    if (remaining_.fetch_sub(1) == 1) {
+      // All inputs succeeded, so Fail has not been called
+      promise_.SetValue(std::apply(
+          [](auto&... values) {
+            return std::tuple<Ts...>(std::move(*values)...);
+          },
+          values_));
+    }
+  }
+
+ private:
+  void Fail(std::exception_ptr ex) {
+    if (!failed_.exchange(true)) {
+      promise_.SetException(ex);
+    }
+  }
+
+ private:
+  std::tuple<std::optional<Ts>...> values_;  // Each slot has one writer
+  twist::stdlike::atomic<size_t> remaining_;
+  twist::stdlike::atomic<bool> failed_{false};
+  Promise<std::tuple<Ts...>> promise_;
+};
+
+template <typename T>
+class FirstOfCombinator {
+ public:
+  explicit FirstOfCombinator(size_t inputs) : inputs_(inputs) {
+  }
+
+  Future<T> MakeFuture() {
+    return promise_.MakeFuture();
+  }
+
+  void Set(Future<T> ready) {
+    std::optional<T> value;
+    std::exception_ptr ex;
+    try {
+      value.emplace(ready.Get());
+    } catch (...) {
+      ex = std::current_exception();
+    }
+
+    if (value.has_value()) {
+      if (!done_.exchange(true)) {
+        promise_.SetValue(std::move(*value));
+      }
+    } else if (failures_.fetch_add(1) + 1 == inputs_) {
+      // Every input failed, report the last error
+      if (!done_.exchange(true)) {
+        promise_.SetException(ex);
+      }
+    }
+  }
+
+ private:
+  const size_t inputs_;
+  twist::stdlike::atomic<size_t> failures_{0};
+  twist::stdlike::atomic<bool> done_{false};
+  Promise<T> promise_;
+};
+
+template <typename... Ts, size_t... Indices>
+void SubscribeAll(std::shared_ptr<AllCombinator<Ts...>> combinator,
+                  std::index_sequence<Indices...>, Future<Ts>... futures) {
+  (std::move(futures).Subscribe(
+       [combinator](Future<Ts> ready) mutable {
+         combinator->template Set<Indices>(std::move(ready));
+       }),
+   ...);
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Fan-in: completes with all values when every input succeeds,
+// or with the first exception. All() is ready right away
+// Usage:
+//   auto both = All(std::move(f1), std::move(f2));
+//   auto [x, y] = std::move(both).Get();
+
+template <typename... Ts>
+Future<std::tuple<Ts...>> All(Future<Ts>... futures) {
+  if constexpr (sizeof...(Ts) == 0) {
+    Promise<std::tuple<>> promise;
+    auto all = promise.MakeFuture();
+    promise.SetValue({});
+    return all;
+  } else {
+    auto combinator = std::make_shared<detail::AllCombinator<Ts...>>();
+    auto all = combinator->MakeFuture();
+    detail::SubscribeAll(combinator, std::index_sequence_for<Ts...>{},
+                         std::move(futures)...);
+    return all;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Completes with the first value produced by any input,
+// or with the last exception if every input fails
+
+template <typename T, typename... Ts>
+Future<T> FirstOf(Future<T> first, Future<Ts>... rest) {
+  static_assert((std::is_same_v<T, Ts> && ...));
+
+  auto combinator =
+      std::make_shared<detail::FirstOfCombinator<T>>(1 + sizeof...(rest));
+  auto first_of = combinator->MakeFuture();
+
+  auto subscribe = [&combinator](Future<T> future) {
+    std::move(future).Subscribe([combinator](Future<T> ready) mutable {
+      combinator->Set(std::move(ready));
+    });
+  };
+  subscribe(std::move(first));
+  (subscribe(std::move(rest)), ...);
+
+  return first_of;
+}
+
+}  // namespace stdlike
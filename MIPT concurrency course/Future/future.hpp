@@ -2,11 +2,22 @@
 
 #include <memory>
 #include <cassert>
+#include <exception>
+#include <type_traits>
 
 #include <futures/channel.hpp>
 
+#include <wheels/support/function.hpp>
+
 namespace stdlike {
 
+template <typename T>
+class Promise;
+
+// Value of futures that carry no value,
+// e.g. the result of a void continuation
+struct Unit {};
+
 template <typename T>
 class Future {
   template <typename U>
@@ -27,13 +38,60 @@ class Future {
     return std::move(channel_->Get());
   }
 
+  // One-shot
+  // Invokes callback with ready future (Get will not block):
+  // right away if result is already set, otherwise
+  // in the thread that fulfills the promise
+  void Subscribe(wheels::UniqueFunction<void(Future<T>)> callback) && {
+    auto channel = std::move(channel_);
+    channel->Subscribe(
+        [callback = std::move(callback)](detail::ChannelRef<T> ready) mutable {
+          callback(Future<T>(std::move(ready)));
+        });
+  }
+
+  // One-shot
+  // Schedules continuation(value) to executor when result is ready,
+  // exceptions bypass continuation and propagate to returned future
+  // Executor - anything with Submit(task), e.g. tp::ThreadPool
+  // void continuation yields Future<Unit>
+  template <typename Executor, typename F>
+  auto Then(Executor& executor, F continuation) && {
+    using R = std::invoke_result_t<F, T>;
+    using U = std::conditional_t<std::is_void_v<R>, Unit, R>;
+
+    Promise<U> promise;
+    auto future = promise.MakeFuture();
+
+    std::move(*this).Subscribe(
+        [&executor, continuation = std::move(continuation),
+         promise = std::move(promise)](Future<T> ready) mutable {
+          executor.Submit([continuation = std::move(continuation),
+                           promise = std::move(promise),
+                           ready = std::move(ready)]() mutable {
+            try {
+              if constexpr (std::is_void_v<R>) {
+                continuation(ready.Get());
+                promise.SetValue(Unit{});
+              } else {
+                promise.SetValue(continuation(ready.Get()));
+              }
+            } catch (...) {
+              promise.SetException(std::current_exception());
+            }
+          });
+        });
+
+    return future;
+  }
+
  private:
-  explicit Future(std::shared_ptr<detail::Channel<T>> channel)
-      : channel_(channel) {
+  explicit Future(detail::ChannelRef<T> channel)
+      : channel_(std::move(channel)) {
   }
 
  private:
-  std::shared_ptr<detail::Channel<T>> channel_;
+  detail::ChannelRef<T> channel_;
 };
 
 }  // namespace stdlike
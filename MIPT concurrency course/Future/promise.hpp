@@ -3,14 +3,12 @@
 #include <futures/channel.hpp>
 #include <futures/future.hpp>
 
-#include <memory>
-
 namespace stdlike {
 
 template <typename T>
 class Promise {
  public:
-  Promise() : channel_(std::make_shared<detail::Channel<T>>()) {
+  Promise() : channel_(detail::ChannelRef<T>::Make()) {
   }
 
   // Non-copyable
@@ -39,7 +37,7 @@ class Promise {
   }
 
  private:
-  std::shared_ptr<detail::Channel<T>> channel_;
+  detail::ChannelRef<T> channel_;
 };
 
 }  // namespace stdlike
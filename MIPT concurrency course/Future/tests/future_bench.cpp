@@ -0,0 +1,114 @@
+#include <futures/future.hpp>
+#include <futures/promise.hpp>
+
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Promise/Future round trip: the pinger fulfills a promise and blocks on
+// a future that the ponger fulfills as soon as it gets the value.
+// Several pairs run side by side
+
+// Ready: SetValue, then Get in the same thread (nobody ever blocks)
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kPairCounts[] = {1, 2, 4, 8, 16, 32};
+static const size_t kRounds = 10000;
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+static void Report(const char* name, size_t threads, double seconds,
+                   std::vector<uint64_t>& latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%-10s threads=%-3zu ops/s=%-11.0f ns: p50=%-8lu p99=%lu\n",
+              name, threads, latencies.size() / seconds,
+              Percentile(latencies, 0.5), Percentile(latencies, 0.99));
+}
+
+template <typename T>
+static std::vector<stdlike::Future<T>> MakeFutures(
+    std::vector<stdlike::Promise<T>>& promises) {
+  std::vector<stdlike::Future<T>> futures;
+  futures.reserve(promises.size());
+  for (auto& promise : promises) {
+    futures.push_back(promise.MakeFuture());
+  }
+  return futures;
+}
+
+void RoundTrip(size_t pairs) {
+  std::vector<std::vector<uint64_t>> latencies(pairs);
+  std::vector<twist::stdlike::thread> threads;
+
+  auto start = Clock::now();
+
+  for (size_t i = 0; i < pairs; ++i) {
+    // Promises are one-shot: a fresh one per round in each direction
+    std::vector<stdlike::Promise<int>> pings(kRounds);
+    std::vector<stdlike::Promise<int>> pongs(kRounds);
+    auto ping_futures = MakeFutures(pings);
+    auto pong_futures = MakeFutures(pongs);
+
+    threads.emplace_back([pongs = std::move(pongs),
+                          ping_futures = std::move(ping_futures)]() mutable {
+      for (size_t j = 0; j < kRounds; ++j) {
+        pongs[j].SetValue(ping_futures[j].Get() + 1);
+      }
+    });
+
+    threads.emplace_back([&local = latencies[i], pings = std::move(pings),
+                          pong_futures = std::move(pong_futures)]() mutable {
+      local.reserve(kRounds);
+      for (size_t j = 0; j < kRounds; ++j) {
+        auto sent = Clock::now();
+        pings[j].SetValue(static_cast<int>(j));
+        pong_futures[j].Get();
+        local.push_back((Clock::now() - sent) / std::chrono::nanoseconds(1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<uint64_t> all;
+  for (auto& local : latencies) {
+    all.insert(all.end(), local.begin(), local.end());
+  }
+  Report("RoundTrip", pairs * 2, seconds, all);
+}
+
+void Ready() {
+  std::vector<uint64_t> latencies;
+  latencies.reserve(kRounds);
+
+  auto start = Clock::now();
+  for (size_t i = 0; i < kRounds; ++i) {
+    auto begin = Clock::now();
+    stdlike::Promise<int> promise;
+    auto future = promise.MakeFuture();
+    promise.SetValue(static_cast<int>(i));
+    future.Get();
+    latencies.push_back((Clock::now() - begin) / std::chrono::nanoseconds(1));
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  Report("Ready", 1, seconds, latencies);
+}
+
+int main() {
+  Ready();
+  for (size_t pairs : kPairCounts) {
+    RoundTrip(pairs);
+  }
+  return 0;
+}
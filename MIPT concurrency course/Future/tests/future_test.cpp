@@ -0,0 +1,174 @@
+#include <futures/combine.hpp>
+#include <futures/future.hpp>
+#include <futures/promise.hpp>
+
+#include <tp/thread_pool.hpp>
+
+#include <twist/stdlike/thread.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+static void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << std::endl;
+    std::abort();
+  }
+}
+
+template <typename T>
+static bool Throws(stdlike::Future<T> future) {
+  try {
+    future.Get();
+  } catch (const std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+void Then(tp::ThreadPool& pool) {
+  // Chain, promise fulfilled after subscription
+  {
+    stdlike::Promise<int> promise;
+    auto future = promise.MakeFuture()
+                      .Then(pool, [](int x) { return x + 1; })
+                      .Then(pool, [](int x) { return std::to_string(x); });
+    promise.SetValue(41);
+    Check(std::move(future).Get() == "42", "Then chain");
+  }
+
+  // Void continuation yields Unit
+  {
+    stdlike::Promise<int> promise;
+    promise.SetValue(7);
+    int seen = 0;
+    stdlike::Future<stdlike::Unit> done =
+        promise.MakeFuture().Then(pool, [&seen](int x) { seen = x; });
+    done.Get();
+    Check(seen == 7, "void continuation");
+  }
+
+  // Exception bypasses continuation
+  {
+    stdlike::Promise<int> promise;
+    bool called = false;
+    auto future = promise.MakeFuture().Then(pool, [&called](int x) {
+      called = true;
+      return x;
+    });
+    promise.SetException(
+        std::make_exception_ptr(std::runtime_error("Then")));
+    Check(Throws(std::move(future)), "Then propagates exception");
+    Check(!called, "Then skips continuation");
+  }
+
+  // Exception thrown by continuation
+  {
+    stdlike::Promise<int> promise;
+    promise.SetValue(1);
+    auto future = promise.MakeFuture().Then(pool, [](int) -> int {
+      throw std::runtime_error("continuation");
+    });
+    Check(Throws(std::move(future)), "Then captures exception");
+  }
+}
+
+void All() {
+  Check(stdlike::All().Get() == std::tuple<>{}, "empty All");
+
+  // Inputs fulfilled from different threads
+  {
+    stdlike::Promise<int> first;
+    stdlike::Promise<std::string> second;
+    auto all = stdlike::All(first.MakeFuture(), second.MakeFuture());
+
+    twist::stdlike::thread producer([&] {
+      second.SetValue("two");
+    });
+    first.SetValue(1);
+    producer.join();
+
+    auto [x, y] = std::move(all).Get();
+    Check(x == 1 && y == "two", "All values");
+  }
+
+  // First failure wins, later inputs are ignored
+  {
+    stdlike::Promise<int> first;
+    stdlike::Promise<int> second;
+    auto all = stdlike::All(first.MakeFuture(), second.MakeFuture());
+    second.SetException(std::make_exception_ptr(std::runtime_error("All")));
+    first.SetValue(1);
+    Check(Throws(std::move(all)), "All propagates exception");
+  }
+}
+
+void FirstOf() {
+  // First value wins
+  {
+    stdlike::Promise<int> first;
+    stdlike::Promise<int> second;
+    auto any = stdlike::FirstOf(first.MakeFuture(), second.MakeFuture());
+    second.SetValue(2);
+    first.SetValue(1);
+    Check(std::move(any).Get() == 2, "FirstOf value");
+  }
+
+  // Failures are skipped while some input may still succeed
+  {
+    stdlike::Promise<int> first;
+    stdlike::Promise<int> second;
+    auto any = stdlike::FirstOf(first.MakeFuture(), second.MakeFuture());
+    first.SetException(std::make_exception_ptr(std::runtime_error("1")));
+    second.SetValue(2);
+    Check(std::move(any).Get() == 2, "FirstOf skips failure");
+  }
+
+  // Every input failed
+  {
+    stdlike::Promise<int> first;
+    stdlike::Promise<int> second;
+    auto any = stdlike::FirstOf(first.MakeFuture(), second.MakeFuture());
+    first.SetException(std::make_exception_ptr(std::runtime_error("1")));
+    second.SetException(std::make_exception_ptr(std::runtime_error("2")));
+    Check(Throws(std::move(any)), "FirstOf fails");
+  }
+
+  // Racing producers
+  for (size_t i = 0; i < 1000; ++i) {
+    std::vector<stdlike::Promise<int>> promises(4);
+    auto any = stdlike::FirstOf(
+        promises[0].MakeFuture(), promises[1].MakeFuture(),
+        promises[2].MakeFuture(), promises[3].MakeFuture());
+
+    std::vector<twist::stdlike::thread> producers;
+    for (int j = 0; j < 4; ++j) {
+      producers.emplace_back([&promises, j] {
+        promises[j].SetValue(j);
+      });
+    }
+    int value = std::move(any).Get();
+    Check(value >= 0 && value < 4, "FirstOf race");
+    for (auto& producer : producers) {
+      producer.join();
+    }
+  }
+}
+
+int main() {
+  tp::ThreadPool pool{4};
+
+  Then(pool);
+  All();
+  FirstOf();
+
+  pool.WaitIdle();
+  pool.Stop();
+
+  std::cout << "OK" << std::endl;
+  return 0;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <twist/stdlike/atomic.hpp>
+#include <twist/util/spin_wait.hpp>
 
 #include <cstdlib>
 
@@ -8,30 +9,82 @@
 
 namespace stdlike {
 
+// Futex mutex with three states (U. Drepper, "Futexes Are Tricky"):
+// unlocked, locked, locked with (possible) waiters
+
+// Lock spins a bounded number of iterations before it parks,
+// Unlock issues a wake syscall only if someone may be sleeping
+
 class Mutex {
+  enum State : uint32_t {
+    Unlocked = 0,
+    Locked = 1,
+    LockedWithWaiters = 2,
+  };
+
  public:
+  static const size_t kDefaultSpinLimit = 100;
+
   void Lock() {
-    while (locked_.exchange(1) == 1) {
-      waiting_.fetch_add(1);
-      locked_.FutexWait(1);
-      waiting_.fetch_sub(1);
+    uint32_t state = State::Unlocked;
+    if (state_.compare_exchange_strong(state, State::Locked)) {
+      return;  // Fast path
+    }
+    if (TryLockWithSpinning(state)) {
+      return;
+    }
+
+    // Slow path: mark mutex as contended and sleep
+    if (state != State::LockedWithWaiters) {
+      state = state_.exchange(State::LockedWithWaiters);
+    }
+    while (state != State::Unlocked) {
+      state_.FutexWait(State::LockedWithWaiters);
+      state = state_.exchange(State::LockedWithWaiters);
     }
   }
 
   void Unlock() {
-    locked_.store(0);
-    if (waiting_.load() > 0) {
-      locked_.FutexWakeOne();
+    if (state_.exchange(State::Unlocked) == State::LockedWithWaiters) {
+      state_.FutexWakeOne();
     }
   }
 
-  Mutex() : locked_(0), waiting_(0) {
+  // BasicLockable
+
+  void lock() {  // NOLINT
+    Lock();
+  }
+
+  void unlock() {  // NOLINT
+    Unlock();
+  }
+
+  explicit Mutex(size_t spin_limit = kDefaultSpinLimit)
+      : state_(State::Unlocked), spin_limit_(spin_limit) {
+  }
+
+ private:
+  // Returns true if mutex has been acquired,
+  // otherwise state holds the last observed value
+  bool TryLockWithSpinning(uint32_t& state) {
+    twist::util::SpinWait spin_wait;
+    for (size_t i = 0; i < spin_limit_; ++i) {
+      spin_wait();
+
+      state = state_.load();
+      if (state == State::Unlocked &&
+          state_.compare_exchange_weak(state, State::Locked)) {
+        return true;
+      }
+    }
+
+    return false;
   }
 
  private:
-  twist::stdlike::atomic<uint32_t> locked_;
-  twist::stdlike::atomic<uint32_t> waiting_;
+  twist::stdlike::atomic<uint32_t> state_;
+  const size_t spin_limit_;
 };
 
 }  // namespace stdlike
-
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/util/spin_wait.hpp>
+
+#include <cstdlib>
+#include <utility>
+
+namespace stdlike {
+
+// Fair queue lock (J. Mellor-Crummey, M. Scott)
+
+// Waiters form a FIFO linked list, each one spins (and then parks)
+// on its own node, so every Unlock touches exactly one waiter
+
+// BasicLockable, can be used with Mutexed<T, QueueMutex> and CondVar
+
+class QueueMutex {
+  static const size_t kCacheLineSize = 64;
+
+  enum NodeState : uint32_t {
+    Waiting = 0,
+    Parked = 1,
+    Granted = 2,
+  };
+
+  struct alignas(kCacheLineSize) Node {
+    twist::stdlike::atomic<Node*> next{nullptr};
+    twist::stdlike::atomic<uint32_t> state{NodeState::Waiting};
+    // Set by Unlock after it has woken a parked owner:
+    // the node may be reused or freed only afterwards
+    twist::stdlike::atomic<bool> released{false};
+    Node* free_next{nullptr};  // Intrusive link in NodeCache
+  };
+
+  // Per-thread pool of nodes: a thread may hold several queue locks at once
+  class NodeCache {
+   public:
+    ~NodeCache() {
+      while (head_ != nullptr) {
+        delete std::exchange(head_, head_->free_next);
+      }
+    }
+
+    Node* Acquire() {
+      if (head_ == nullptr) {
+        return new Node{};
+      }
+      Node* node = std::exchange(head_, head_->free_next);
+      node->next.store(nullptr);
+      node->state.store(NodeState::Waiting);
+      node->released.store(false);
+      return node;
+    }
+
+    void Release(Node* node) {
+      node->free_next = std::exchange(head_, node);
+    }
+
+   private:
+    Node* head_{nullptr};
+  };
+
+ public:
+  static const size_t kDefaultSpinLimit = 100;
+
+  explicit QueueMutex(size_t spin_limit = kDefaultSpinLimit)
+      : spin_limit_(spin_limit) {
+  }
+
+  // Non-copyable
+  QueueMutex(const QueueMutex&) = delete;
+  QueueMutex& operator=(const QueueMutex&) = delete;
+
+  void Lock() {
+    Node* node = LocalNodes().Acquire();
+
+    Node* prev = tail_.exchange(node);
+    if (prev != nullptr) {
+      prev->next.store(node);
+      WaitForHandoff(node);
+    }
+
+    owner_ = node;
+  }
+
+  void Unlock() {
+    Node* node = owner_;
+
+    Node* next = node->next.load();
+    if (next == nullptr) {
+      Node* expected = node;
+      if (tail_.compare_exchange_strong(expected, nullptr)) {
+        LocalNodes().Release(node);
+        return;
+      }
+      // Successor is linking itself right now
+      twist::util::SpinWait spin_wait;
+      while ((next = node->next.load()) == nullptr) {
+        spin_wait();
+      }
+    }
+
+    if (next->state.exchange(NodeState::Granted) == NodeState::Parked) {
+      next->state.FutexWakeOne();
+      next->released.store(true);  // Last access to next
+    }
+    LocalNodes().Release(node);
+  }
+
+  // BasicLockable
+
+  void lock() {  // NOLINT
+    Lock();
+  }
+
+  void unlock() {  // NOLINT
+    Unlock();
+  }
+
+ private:
+  void WaitForHandoff(Node* node) {
+    twist::util::SpinWait spin_wait;
+    for (size_t i = 0; i < spin_limit_; ++i) {
+      if (node->state.load() == NodeState::Granted) {
+        return;
+      }
+      spin_wait();
+    }
+
+    uint32_t state = NodeState::Waiting;
+    if (!node->state.compare_exchange_strong(state, NodeState::Parked)) {
+      return;  // Granted
+    }
+    while (node->state.load() != NodeState::Granted) {
+      node->state.FutexWait(NodeState::Parked);
+    }
+
+    // We have parked, so Unlock is going to wake us up: wait until
+    // it is done with the node, the owner thread may exit and free it
+    while (!node->released.load()) {
+      spin_wait();
+    }
+  }
+
+  static NodeCache& LocalNodes() {
+    static thread_local NodeCache nodes;
+    return nodes;
+  }
+
+ private:
+  twist::stdlike::atomic<Node*> tail_{nullptr};
+  Node* owner_{nullptr};  // Accessed only by the lock holder
+  const size_t spin_limit_;
+};
+
+}  // namespace stdlike
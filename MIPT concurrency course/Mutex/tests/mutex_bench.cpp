@@ -0,0 +1,128 @@
+#include "../mutex.hpp"
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/mutex.hpp>
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Contention benchmark: the three-state spinning Mutex vs the original
+// exchange + waiters counter mutex (and std::mutex for reference)
+
+// Short critical section: a single increment,
+// long one: a few hundred dependent arithmetic operations
+
+static const size_t kThreadCounts[] = {2, 4, 8, 16, 32, 64};
+
+static const size_t kShortOps = 20000;
+static const size_t kLongOps = 5000;
+static const size_t kLongWork = 256;
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the critical section from being optimized away
+static volatile uint64_t sink;
+
+// Mutex before the rework, kept here as the baseline
+class BaselineMutex {
+ public:
+  void Lock() {
+    while (locked_.exchange(1) == 1) {
+      waiting_.fetch_add(1);
+      locked_.FutexWait(1);
+      waiting_.fetch_sub(1);
+    }
+  }
+
+  void Unlock() {
+    locked_.store(0);
+    if (waiting_.load() > 0) {
+      locked_.FutexWakeOne();
+    }
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> locked_{0};
+  twist::stdlike::atomic<uint32_t> waiting_{0};
+};
+
+class StdMutex {
+ public:
+  void Lock() {
+    mutex_.lock();
+  }
+
+  void Unlock() {
+    mutex_.unlock();
+  }
+
+ private:
+  twist::stdlike::mutex mutex_;
+};
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+template <class Mutex>
+void Run(const char* name, size_t threads, size_t ops, size_t work) {
+  Mutex mutex;
+  uint64_t state = 1;  // guarded by mutex
+
+  std::vector<std::vector<uint64_t>> latencies(threads);
+
+  auto start = Clock::now();
+
+  std::vector<twist::stdlike::thread> workers;
+  for (size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&, i] {
+      auto& local = latencies[i];
+      local.reserve(ops);
+      for (size_t j = 0; j < ops; ++j) {
+        auto begin = Clock::now();
+        mutex.Lock();
+        for (size_t k = 0; k < work; ++k) {
+          state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        mutex.Unlock();
+        local.push_back((Clock::now() - begin) / std::chrono::nanoseconds(1));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  sink = state;
+
+  std::vector<uint64_t> all;
+  for (auto& local : latencies) {
+    all.insert(all.end(), local.begin(), local.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  std::printf("%-10s %-5s threads=%-3zu ops/s=%-12.0f lock+unlock ns: "
+              "p50=%-8lu p99=%lu\n",
+              name, work > 1 ? "long" : "short", threads,
+              all.size() / seconds, Percentile(all, 0.5),
+              Percentile(all, 0.99));
+}
+
+int main() {
+  for (size_t threads : kThreadCounts) {
+    Run<BaselineMutex>("Baseline", threads, kShortOps, 1);
+    Run<stdlike::Mutex>("Mutex", threads, kShortOps, 1);
+    Run<StdMutex>("std::mutex", threads, kShortOps, 1);
+  }
+  for (size_t threads : kThreadCounts) {
+    Run<BaselineMutex>("Baseline", threads, kLongOps, kLongWork);
+    Run<stdlike::Mutex>("Mutex", threads, kLongOps, kLongWork);
+    Run<StdMutex>("std::mutex", threads, kLongOps, kLongWork);
+  }
+  return 0;
+}
@@ -0,0 +1,75 @@
+#include "../mutex.hpp"
+#include "../queue_mutex.hpp"
+
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Acquire latency of the fair queue lock vs the barging futex mutex:
+// QueueMutex should trade some throughput for a much shorter tail
+
+// Every thread takes the lock kOpsPerThread times, the time from
+// the Lock call to the acquisition is recorded for every operation
+
+static const size_t kOpsPerThread = 20000;
+static const size_t kThreadCounts[] = {2, 4, 8, 16, 32, 64};
+
+using Clock = std::chrono::steady_clock;
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+template <class Mutex>
+void Run(const char* name, size_t threads) {
+  Mutex mutex;
+  size_t counter = 0;  // guarded by mutex
+
+  std::vector<std::vector<uint64_t>> latencies(threads);
+
+  auto start = Clock::now();
+
+  std::vector<twist::stdlike::thread> workers;
+  for (size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&, i] {
+      auto& local = latencies[i];
+      local.reserve(kOpsPerThread);
+      for (size_t j = 0; j < kOpsPerThread; ++j) {
+        auto begin = Clock::now();
+        mutex.Lock();
+        auto acquired = Clock::now();
+        ++counter;
+        mutex.Unlock();
+        local.push_back((acquired - begin) / std::chrono::nanoseconds(1));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<uint64_t> all;
+  for (auto& local : latencies) {
+    all.insert(all.end(), local.begin(), local.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  std::printf("%-12s threads=%-3zu ops/s=%-12.0f acquire ns: p50=%-8lu "
+              "p99=%-10lu max=%lu\n",
+              name, threads, counter / seconds, Percentile(all, 0.5),
+              Percentile(all, 0.99), all.back());
+}
+
+int main() {
+  for (size_t threads : kThreadCounts) {
+    Run<stdlike::Mutex>("Mutex", threads);
+    Run<stdlike::QueueMutex>("QueueMutex", threads);
+  }
+  return 0;
+}
@@ -3,16 +3,24 @@
 
 #include <twist/stdlike/mutex.hpp>
 
+#include "shared_mutex.hpp"
+
+// std::lock_guard
+#include <mutex>
+// std::shared_lock
+#include <shared_mutex>
+
 namespace util {
 
 //////////////////////////////////////////////////////////////////////
 
 // Safe API for mutual exclusion
 
-template <typename T>
-class Mutexed {
-  using MutexImpl = twist::stdlike::mutex;
+// MutexImpl - BasicLockable
+// https://en.cppreference.com/w/cpp/named_req/BasicLockable
 
+template <typename T, typename MutexImpl = twist::stdlike::mutex>
+class Mutexed {
   class UniqueRef {
    public:
     // Non-copyable
@@ -37,6 +45,31 @@ class Mutexed {
     std::lock_guard<MutexImpl> guard_;
   };
 
+  class SharedRef {
+   public:
+    // Non-copyable
+    SharedRef(const SharedRef&) = delete;
+
+    // Non-movable
+    SharedRef(SharedRef&&) = delete;
+
+    SharedRef(const T& object, MutexImpl& mutex)
+        : object_(object), guard_(mutex) {
+    }
+
+    const T& operator*() const {
+      return object_;
+    }
+
+    const T* operator->() const {
+      return &object_;
+    }
+
+   private:
+    const T& object_;
+    std::shared_lock<MutexImpl> guard_;
+  };
+
  public:
   // https://eli.thegreenplace.net/2014/perfect-forwarding-and-universal-references-in-c/
   template <typename... Args>
@@ -47,6 +80,11 @@ class Mutexed {
     return {object_, mutex_};
   }
 
+  // Requires MutexImpl to be SharedLockable, see SharedMutexed
+  SharedRef ReadLock() {
+    return {object_, mutex_};
+  }
+
  private:
   T object_;
   MutexImpl mutex_;  // Guards access to object_
@@ -59,10 +97,25 @@ class Mutexed {
 //   Mutexed<vector<int>> ints;
 //   Locked(ints)->push_back(42);
 
-template <typename T>
-auto Locked(Mutexed<T>& object) {
+template <typename T, typename MutexImpl>
+auto Locked(Mutexed<T, MutexImpl>& object) {
   return object.Lock();
 }
 
+//////////////////////////////////////////////////////////////////////
+
+// Mutexed for read-mostly objects
+// Usage:
+//   SharedMutexed<RoutingTable> routes;
+//   ReadLocked(routes)->Lookup(key);
+
+template <typename T>
+using SharedMutexed = Mutexed<T, SharedMutex>;
+
+template <typename T, typename MutexImpl>
+auto ReadLocked(Mutexed<T, MutexImpl>& object) {
+  return object.ReadLock();
+}
+
 }  // namespace util
 
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/mutex.hpp>
+#include <twist/util/spin_wait.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace util {
+
+//////////////////////////////////////////////////////////////////////
+
+// Mutexed for read-mostly trivially copyable objects
+
+// Readers take optimistic snapshots and retry if a writer
+// intervened, they never write to shared memory.
+// Writers are serialized by a mutex and publish a modified copy
+
+// Usage:
+//   SeqLockMutexed<Config> config;
+//   Config snapshot = config.Read();
+//   config.Lock()->timeout = 42;
+
+template <typename T>
+class SeqLockMutexed {
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(std::is_default_constructible_v<T>);
+
+  // Object is stored word by word, so that racy reads are well-defined
+  static const size_t kWords =
+      (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  using Words = std::array<uint64_t, kWords>;
+
+  class WriteRef {
+   public:
+    // Non-copyable
+    WriteRef(const WriteRef&) = delete;
+
+    // Non-movable
+    WriteRef(WriteRef&&) = delete;
+
+    explicit WriteRef(SeqLockMutexed& owner)
+        : owner_(owner), guard_(owner.writer_mutex_) {
+      // Writers are serialized, so this read is consistent
+      object_ = owner_.Load();
+    }
+
+    ~WriteRef() {
+      owner_.Publish(object_);
+    }
+
+    T& operator*() {
+      return object_;
+    }
+
+    T* operator->() {
+      return &object_;
+    }
+
+   private:
+    SeqLockMutexed& owner_;
+    std::lock_guard<twist::stdlike::mutex> guard_;
+    T object_;
+  };
+
+ public:
+  template <typename... Args>
+  explicit SeqLockMutexed(Args&&... args) {
+    Store(T{std::forward<Args>(args)...});
+  }
+
+  // Consistent snapshot of the object
+  T Read() const {
+    twist::util::SpinWait spin_wait;
+    while (true) {
+      uint32_t sequence = sequence_.load();
+      if (sequence % 2 == 0) {
+        T object = Load();
+        if (sequence_.load() == sequence) {
+          return object;
+        }
+      }
+      spin_wait();
+    }
+  }
+
+  // Modifications become visible to readers when WriteRef is destroyed
+  WriteRef Lock() {
+    return WriteRef{*this};
+  }
+
+ private:
+  T Load() const {
+    Words words;
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load();
+    }
+    T object;
+    std::memcpy(&object, words.data(), sizeof(T));
+    return object;
+  }
+
+  void Store(const T& object) {
+    Words words{};
+    std::memcpy(words.data(), &object, sizeof(T));
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i]);
+    }
+  }
+
+  void Publish(const T& object) {
+    sequence_.fetch_add(1);  // Odd: write in progress
+    Store(object);
+    sequence_.fetch_add(1);
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> sequence_{0};
+  std::array<twist::stdlike::atomic<uint64_t>, kWords> words_;
+  twist::stdlike::mutex writer_mutex_;  // Serializes writers
+};
+
+}  // namespace util
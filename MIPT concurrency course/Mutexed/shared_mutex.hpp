@@ -0,0 +1,106 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <cassert>
+#include <cstdint>
+
+namespace util {
+
+// Reader-writer lock on a single futex word
+
+// Writer-preferring: new readers wait while a writer holds or waits for
+// the lock. Uncontended lock_shared/unlock_shared is a single atomic RMW
+
+// Lockable + SharedLockable, can be used with
+// std::lock_guard, std::unique_lock and std::shared_lock
+
+// Futex word is 32 bits wide: at most kMaxReaders readers
+// may hold the lock at once
+
+class SharedMutex {
+  // State layout:
+  //   bit 31      - writer holds the lock
+  //   bit 30      - some readers sleep waiting for writer
+  //   bits 16..29 - number of waiting writers
+  //   bits 0..15  - number of readers holding the lock
+  static const uint32_t kWriter = 1u << 31;
+  static const uint32_t kReadersWaiting = 1u << 30;
+  static const uint32_t kWaitingWriter = 1u << 16;
+  static const uint32_t kWaitingWritersMask = ((1u << 14) - 1) << 16;
+  static const uint32_t kReadersMask = (1u << 16) - 1;
+
+ public:
+  static const uint32_t kMaxReaders = kReadersMask;
+
+  // Exclusive access
+
+  void lock() {  // NOLINT
+    uint32_t state = 0;
+    if (state_.compare_exchange_strong(state, kWriter)) {
+      return;  // Fast path
+    }
+
+    state = state_.fetch_add(kWaitingWriter);
+    assert((state & kWaitingWritersMask) != kWaitingWritersMask);
+    while (true) {
+      state = state_.load();
+      if ((state & (kWriter | kReadersMask)) == 0) {
+        if (state_.compare_exchange_weak(state,
+                                         state - kWaitingWriter + kWriter)) {
+          return;
+        }
+        continue;
+      }
+      state_.FutexWait(state);
+    }
+  }
+
+  void unlock() {  // NOLINT
+    uint32_t state = state_.load();
+    while (!state_.compare_exchange_weak(
+        state, state & ~(kWriter | kReadersWaiting))) {
+    }
+    if ((state & (kReadersWaiting | kWaitingWritersMask)) != 0) {
+      state_.FutexWakeAll();
+    }
+  }
+
+  // Shared access
+
+  void lock_shared() {  // NOLINT
+    uint32_t state = state_.load();
+    while (true) {
+      if ((state & (kWriter | kWaitingWritersMask)) == 0) {
+        // Reader count would carry into the waiting writers
+        assert((state & kReadersMask) < kMaxReaders);
+        if (state_.compare_exchange_weak(state, state + 1)) {
+          return;
+        }
+        continue;
+      }
+
+      if ((state & kReadersWaiting) == 0) {
+        if (!state_.compare_exchange_weak(state, state | kReadersWaiting)) {
+          continue;
+        }
+        state |= kReadersWaiting;
+      }
+      state_.FutexWait(state);
+      state = state_.load();
+    }
+  }
+
+  void unlock_shared() {  // NOLINT
+    uint32_t state = state_.fetch_sub(1);
+    // Last reader lets waiting writers in
+    if ((state & kReadersMask) == 1 && (state & kWaitingWritersMask) != 0) {
+      state_.FutexWakeAll();
+    }
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> state_{0};
+};
+
+}  // namespace util
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/mutex.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <variant>
+
+namespace solutions {
+
+namespace detail {
+
+// Thread parked on one or several channels
+
+// A readiness event fires the first waiter that has not been fired yet,
+// so every Send/Recv wakes at most one thread
+class Selector {
+  static const uint32_t kWaiting = 0;
+
+ public:
+  // Called under the lock of the channel at position index.
+  // The selector leaves only after it re-acquires that lock,
+  // so it is safe to wake it up right here
+  bool TryFire(size_t index) {
+    uint32_t expected = kWaiting;
+    if (ready_.compare_exchange_strong(expected, index + 1)) {
+      ready_.FutexWakeOne();
+      return true;
+    }
+    return false;
+  }
+
+  void Park() {
+    while (ready_.load() == kWaiting) {
+      ready_.FutexWait(kWaiting);
+    }
+  }
+
+  // Position of the channel that has fired the selector
+  std::optional<size_t> Fired() const {
+    if (uint32_t ready = ready_.load(); ready != kWaiting) {
+      return ready - 1;
+    }
+    return std::nullopt;
+  }
+
+ private:
+  // kWaiting or position of the fired channel + 1
+  twist::stdlike::atomic<uint32_t> ready_{kWaiting};
+};
+
+// Entry of a selector in the wait list of one channel
+struct WaitLink {
+  Selector* selector{nullptr};
+  size_t index{0};
+
+  WaitLink* prev{nullptr};
+  WaitLink* next{nullptr};
+  bool linked{false};
+};
+
+// Intrusive FIFO list, guarded by the channel lock
+class WaitList {
+ public:
+  void Push(WaitLink* link) {
+    link->prev = tail_;
+    link->next = nullptr;
+    if (tail_ != nullptr) {
+      tail_->next = link;
+    } else {
+      head_ = link;
+    }
+    tail_ = link;
+    link->linked = true;
+  }
+
+  void Remove(WaitLink* link) {
+    if (!link->linked) {
+      return;  // Already fired
+    }
+    (link->prev != nullptr ? link->prev->next : head_) = link->next;
+    (link->next != nullptr ? link->next->prev : tail_) = link->prev;
+    link->linked = false;
+  }
+
+  // Skips selectors that have already been fired by other channels
+  void WakeOne() {
+    while (head_ != nullptr) {
+      WaitLink* link = head_;
+      Remove(link);
+      if (link->selector->TryFire(link->index)) {
+        return;
+      }
+    }
+  }
+
+  void WakeAll() {
+    while (head_ != nullptr) {
+      WaitLink* link = head_;
+      Remove(link);
+      link->selector->TryFire(link->index);
+    }
+  }
+
+ private:
+  WaitLink* head_{nullptr};
+  WaitLink* tail_{nullptr};
+};
+
+// Calls f(std::integral_constant<size_t, I>{}) for I == index
+template <typename F, size_t... I>
+void VisitIndex(size_t index, std::index_sequence<I...>, F&& f) {
+  ((I == index ? (f(std::integral_constant<size_t, I>{}), 0) : 0), ...);
+}
+
+}  // namespace detail
+
+template <typename T>
+class Channel;
+
+template <typename... Ts>
+std::variant<std::optional<Ts>...> Select(Channel<Ts>&... channels);
+
+// Bounded closable Multi-Producer/Multi-Consumer channel (Go-style)
+
+// Values are buffered under a short critical section, threads that have
+// to wait park on a futex of their own and are woken up one per event
+
+template <typename T>
+class Channel {
+  template <typename... Ts>
+  friend std::variant<std::optional<Ts>...> Select(Channel<Ts>&... channels);
+
+ public:
+  explicit Channel(size_t capacity) : capacity_(capacity) {
+    assert(capacity > 0);
+  }
+
+  // Non-copyable
+  Channel(const Channel&) = delete;
+  Channel& operator=(const Channel&) = delete;
+
+  // Waits for free space, returns false if channel is closed
+  bool Send(T value) {
+    std::unique_lock guard(mutex_);
+    while (true) {
+      if (closed_) {
+        return false;
+      }
+      if (buffer_.size() < capacity_) {
+        Push(std::move(value));
+        return true;
+      }
+      Wait(senders_, guard);
+    }
+  }
+
+  // Moves from value only on success
+  bool TrySend(T& value) {
+    std::lock_guard guard(mutex_);
+    if (closed_ || buffer_.size() == capacity_) {
+      return false;
+    }
+    Push(std::move(value));
+    return true;
+  }
+
+  // Waits for a value, returns nullopt if channel is closed and drained
+  std::optional<T> Recv() {
+    std::unique_lock guard(mutex_);
+    while (true) {
+      if (!buffer_.empty()) {
+        return Pop();
+      }
+      if (closed_) {
+        return std::nullopt;
+      }
+      Wait(receivers_, guard);
+    }
+  }
+
+  std::optional<T> TryRecv() {
+    std::lock_guard guard(mutex_);
+    if (buffer_.empty()) {
+      return std::nullopt;
+    }
+    return Pop();
+  }
+
+  // Buffered values can still be received
+  void Close() {
+    std::lock_guard guard(mutex_);
+    closed_ = true;
+    receivers_.WakeAll();
+    senders_.WakeAll();
+  }
+
+ private:
+  // Guarded by mutex_
+
+  void Push(T value) {
+    buffer_.push_back(std::move(value));
+    receivers_.WakeOne();
+  }
+
+  T Pop() {
+    T value = std::move(buffer_.front());
+    buffer_.pop_front();
+    senders_.WakeOne();
+    return value;
+  }
+
+  void Wait(detail::WaitList& waiters,
+            std::unique_lock<twist::stdlike::mutex>& guard) {
+    detail::Selector selector;
+    detail::WaitLink link{&selector};
+    waiters.Push(&link);
+
+    guard.unlock();
+    selector.Park();
+    guard.lock();
+
+    waiters.Remove(&link);
+  }
+
+  // Select support
+
+  // Returns true if Recv would not block,
+  // value is left empty if channel is closed and drained
+  bool TryRecvOrClosed(std::optional<T>& value) {
+    std::lock_guard guard(mutex_);
+    if (!buffer_.empty()) {
+      value.emplace(Pop());
+      return true;
+    }
+    return closed_;
+  }
+
+  // Returns false (and does not subscribe) if Recv would not block
+  bool Subscribe(detail::WaitLink* link) {
+    std::lock_guard guard(mutex_);
+    if (!buffer_.empty() || closed_) {
+      return false;
+    }
+    receivers_.Push(link);
+    return true;
+  }
+
+  void Unsubscribe(detail::WaitLink* link) {
+    std::lock_guard guard(mutex_);
+    receivers_.Remove(link);
+  }
+
+ private:
+  const size_t capacity_;
+
+  twist::stdlike::mutex mutex_;
+  std::deque<T> buffer_;  // guarded by mutex_
+  bool closed_{false};    // guarded by mutex_
+
+  detail::WaitList senders_;    // guarded by mutex_
+  detail::WaitList receivers_;  // guarded by mutex_
+};
+
+// Waits until one of the channels is ready and receives from it.
+// index() of the result is the position of that channel,
+// the value is nullopt if the channel is closed and drained
+
+// The selector parks once for all channels, ready channels are
+// polled starting from a rotating position for fairness
+template <typename... Ts>
+std::variant<std::optional<Ts>...> Select(Channel<Ts>&... channels) {
+  using Result = std::variant<std::optional<Ts>...>;
+  static constexpr size_t kCount = sizeof...(Ts);
+  static constexpr auto kIndices = std::index_sequence_for<Ts...>{};
+  static_assert(kCount > 0);
+
+  auto all = std::tie(channels...);
+
+  static thread_local size_t next_start = 0;
+  size_t start = next_start++ % kCount;
+
+  while (true) {
+    for (size_t k = 0; k < kCount; ++k) {
+      std::optional<Result> result;
+      detail::VisitIndex((start + k) % kCount, kIndices, [&](auto index) {
+        static constexpr size_t I = decltype(index)::value;
+        std::optional<std::tuple_element_t<I, std::tuple<Ts...>>> value;
+        if (std::get<I>(all).TryRecvOrClosed(value)) {
+          result.emplace(std::in_place_index<I>, std::move(value));
+        }
+      });
+      if (result.has_value()) {
+        return std::move(*result);
+      }
+    }
+
+    detail::Selector selector;
+    std::array<detail::WaitLink, kCount> links;
+
+    size_t subscribed = 0;
+    bool park = true;
+    for (; subscribed < kCount && park; ++subscribed) {
+      links[subscribed].selector = &selector;
+      links[subscribed].index = subscribed;
+      detail::VisitIndex(subscribed, kIndices, [&](auto index) {
+        static constexpr size_t I = decltype(index)::value;
+        park = std::get<I>(all).Subscribe(&links[I]);
+      });
+    }
+
+    if (park) {
+      selector.Park();
+    } else {
+      start = subscribed - 1;  // Became ready before we parked
+    }
+
+    for (size_t i = 0; i < subscribed; ++i) {
+      detail::VisitIndex(i, kIndices, [&](auto index) {
+        static constexpr size_t I = decltype(index)::value;
+        std::get<I>(all).Unsubscribe(&links[I]);
+      });
+    }
+
+    // We may have been fired even if we did not park:
+    // that channel goes first, otherwise its event would be lost
+    if (auto fired = selector.Fired()) {
+      start = *fired;
+    }
+  }
+}
+
+}  // namespace solutions
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace solutions {
+
+// Bounded Blocking Multi-Producer/Multi-Consumer (MPMC) Queue
+
+// Drop-in replacement for BlockingQueue built on a ring buffer
+// with per-slot sequence numbers (D. Vyukov's bounded MPMC queue)
+
+// Put/Take are lock-free while the queue is neither full nor empty,
+// callers park on a futex only when they have to wait
+
+template <typename T>
+class LockFreeBlockingQueue {
+ private:
+  static const size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Slot {
+    // pos         - free, waiting for producer with ticket pos
+    // pos + 1     - holds value, waiting for consumer with ticket pos
+    twist::stdlike::atomic<size_t> sequence{0};
+    std::optional<T> value;
+  };
+
+  // Futex word + number of threads sleeping on it
+  struct alignas(kCacheLineSize) WaitPoint {
+    twist::stdlike::atomic<uint32_t> epoch{0};
+    twist::stdlike::atomic<uint32_t> sleepers{0};
+  };
+
+ public:
+  explicit LockFreeBlockingQueue(size_t capacity)
+      : capacity_(capacity), slots_(std::make_unique<Slot[]>(capacity)) {
+    assert(capacity > 0);
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].sequence.store(i);
+    }
+  }
+
+  // Non-copyable
+  LockFreeBlockingQueue(const LockFreeBlockingQueue&) = delete;
+  LockFreeBlockingQueue& operator=(const LockFreeBlockingQueue&) = delete;
+
+  // Inserts the specified element into this queue,
+  // waiting if necessary for space to become available.
+  void Put(T value) {
+    while (!TryPut(value)) {
+      uint32_t epoch = not_full_.epoch.load();
+      not_full_.sleepers.fetch_add(1);
+      // Re-check after announcing ourselves, pairs with Wake
+      if (TryPut(value)) {
+        not_full_.sleepers.fetch_sub(1);
+        break;
+      }
+      not_full_.epoch.FutexWait(epoch);
+      not_full_.sleepers.fetch_sub(1);
+    }
+    Wake(not_empty_);
+  }
+
+  // Retrieves and removes the head of this queue,
+  // waiting if necessary until an element becomes available
+  T Take() {
+    std::optional<T> value;
+    while (!(value = TryTakeImpl())) {
+      uint32_t epoch = not_empty_.epoch.load();
+      not_empty_.sleepers.fetch_add(1);
+      if ((value = TryTakeImpl())) {
+        not_empty_.sleepers.fetch_sub(1);
+        break;
+      }
+      not_empty_.epoch.FutexWait(epoch);
+      not_empty_.sleepers.fetch_sub(1);
+    }
+    Wake(not_full_);
+    return std::move(*value);
+  }
+
+ private:
+  // Moves from value only on success
+  bool TryPut(T& value) {
+    size_t pos = enqueue_pos_.load();
+    while (true) {
+      Slot& slot = slots_[pos % capacity_];
+      size_t sequence = slot.sequence.load();
+
+      if (sequence == pos) {
+        // Slot is free, try to claim it
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1)) {
+          slot.value.emplace(std::move(value));
+          slot.sequence.store(pos + 1);
+          return true;
+        }
+      } else if (sequence < pos) {
+        // Slot still holds value from the previous lap: queue is full
+        return false;
+      } else {
+        // Another producer claimed this slot
+        pos = enqueue_pos_.load();
+      }
+    }
+  }
+
+  std::optional<T> TryTakeImpl() {
+    size_t pos = dequeue_pos_.load();
+    while (true) {
+      Slot& slot = slots_[pos % capacity_];
+      size_t sequence = slot.sequence.load();
+
+      if (sequence == pos + 1) {
+        // Slot holds value, try to claim it
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1)) {
+          std::optional<T> value = std::move(slot.value);
+          slot.value.reset();
+          // Free the slot for the producer of the next lap
+          slot.sequence.store(pos + capacity_);
+          return value;
+        }
+      } else if (sequence < pos + 1) {
+        // Slot has not been filled yet: queue is empty
+        return std::nullopt;
+      } else {
+        // Another consumer claimed this slot
+        pos = dequeue_pos_.load();
+      }
+    }
+  }
+
+  static void Wake(WaitPoint& point) {
+    if (point.sleepers.load() > 0) {
+      point.epoch.fetch_add(1);
+      point.epoch.FutexWakeOne();
+    }
+  }
+
+ private:
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+
+  alignas(kCacheLineSize) twist::stdlike::atomic<size_t> enqueue_pos_{0};
+  alignas(kCacheLineSize) twist::stdlike::atomic<size_t> dequeue_pos_{0};
+
+  WaitPoint not_full_;
+  WaitPoint not_empty_;
+};
+
+}  // namespace solutions
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <twist/stdlike/atomic.hpp>
 #include <twist/stdlike/mutex.hpp>
 #include <twist/stdlike/condition_variable.hpp>
 
 // std::lock_guard, std::unique_lock
 #include <mutex>
+#include <chrono>
 #include <cstdint>
 
 namespace solutions {
@@ -14,35 +16,122 @@ namespace solutions {
 // Semaphores are often used to restrict the number of threads
 // than can access some (physical or logical) resource
 
+// Permits live in a single futex word: Acquire and Release are
+// one CAS / one fetch_add when nobody waits, Release(n) wakes
+// at most n sleepers (all of them if someone waits for several permits)
+
+// Timed waiters sleep on a condvar, Release touches its mutex
+// only when there are any
+
 class Semaphore {
  public:
+  using Clock = std::chrono::steady_clock;
+
   // Creates a Semaphore with the given number of permits
-  explicit Semaphore(size_t initial) : permits_(initial) {
+  explicit Semaphore(size_t initial)
+      : permits_(static_cast<uint32_t>(initial)) {
   }
 
-  // Acquires a permit from this semaphore,
-  // blocking until one is available
-  void Acquire() {
-    std::unique_lock<twist::stdlike::mutex> guard(mutex_);
-    while (permits_ == 0) {
-      permits_available_.wait(guard);
+  // Non-copyable
+  Semaphore(const Semaphore&) = delete;
+  Semaphore& operator=(const Semaphore&) = delete;
+
+  // Acquires count permits from this semaphore,
+  // blocking until they are available
+  void Acquire(size_t count = 1) {
+    while (!TryAcquire(count)) {
+      WaitFor(count);
     }
-    --permits_;
   }
 
-  // Releases a permit, returning it to the semaphore
-  void Release() {
-    std::unique_lock<twist::stdlike::mutex> guard(mutex_);
-    ++permits_;
-    permits_available_.notify_all();
+  // Acquires count permits only if they are available right now
+  bool TryAcquire(size_t count = 1) {
+    uint32_t permits = permits_.load();
+    while (permits >= count) {
+      if (permits_.compare_exchange_weak(permits, permits - count)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns false if permits have not been acquired before the deadline
+  bool TryAcquireUntil(Clock::time_point deadline, size_t count = 1) {
+    while (!TryAcquire(count)) {
+      std::unique_lock<twist::stdlike::mutex> guard(mutex_);
+      // Pairs with Release: either we see new permits
+      // or Release sees us and notifies under mutex_
+      timed_waiters_.fetch_add(1);
+      bool available = permits_available_.wait_until(guard, deadline, [&] {
+        return permits_.load() >= count;
+      });
+      timed_waiters_.fetch_sub(1);
+
+      if (!available) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename Rep, typename Period>
+  bool TryAcquireFor(std::chrono::duration<Rep, Period> timeout,
+                     size_t count = 1) {
+    return TryAcquireUntil(Clock::now() + timeout, count);
+  }
+
+  // Releases count permits, returning them to the semaphore
+  void Release(size_t count = 1) {
+    permits_.fetch_add(static_cast<uint32_t>(count));
+
+    if (const uint32_t waiters = waiters_.load(); waiters > 0) {
+      if (bulk_waiters_.load() > 0 || count >= waiters) {
+        // Anyone may be the one these permits are enough for
+        permits_.FutexWakeAll();
+      } else {
+        for (size_t i = 0; i < count; ++i) {
+          permits_.FutexWakeOne();
+        }
+      }
+    }
+
+    if (timed_waiters_.load() > 0) {
+      std::lock_guard<twist::stdlike::mutex> guard(mutex_);
+      permits_available_.notify_all();
+    }
+  }
+
+ private:
+  // Sleeps until permit count changes
+  void WaitFor(size_t count) {
+    uint32_t permits = permits_.load();
+    if (permits >= count) {
+      return;
+    }
+
+    waiters_.fetch_add(1);
+    if (count > 1) {
+      bulk_waiters_.fetch_add(1);
+    }
+    // Futex re-checks permits_ after we have announced ourselves,
+    // pairs with Release
+    permits_.FutexWait(permits);
+    if (count > 1) {
+      bulk_waiters_.fetch_sub(1);
+    }
+    waiters_.fetch_sub(1);
   }
 
  private:
-  size_t permits_;  // guarded by mutex_
+  twist::stdlike::atomic<uint32_t> permits_;
+  twist::stdlike::atomic<uint32_t> waiters_{0};
+  // Waiters for more than one permit
+  twist::stdlike::atomic<uint32_t> bulk_waiters_{0};
 
+  // Timed waits
+  twist::stdlike::atomic<uint32_t> timed_waiters_{0};
   twist::stdlike::mutex mutex_;
   twist::stdlike::condition_variable permits_available_;
 };
 
 }  // namespace solutions
-
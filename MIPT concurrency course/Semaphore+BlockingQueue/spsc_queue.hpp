@@ -0,0 +1,237 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/util/spin_wait.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace solutions {
+
+// Bounded Blocking Single-Producer/Single-Consumer (SPSC) Queue
+
+// Ring buffer with head and tail on separate cache lines. Each side
+// keeps a cached copy of the other side's index and rereads the shared
+// one only when the ring looks full (producer) or empty (consumer),
+// so in steady state a cache line changes hands once per batch.
+
+// Push/Pop never block while the ring is neither full nor empty,
+// the waiting side spins briefly and then parks on a futex.
+// PushN/PopN move whole batches with a single index update
+
+template <typename T>
+class SpscQueue {
+ private:
+  static const size_t kCacheLineSize = 64;
+  static const size_t kSpinLimit = 100;
+
+  struct Storage {
+    alignas(T) std::byte bytes[sizeof(T)];
+  };
+
+  // Futex word + number of threads sleeping on it
+  struct alignas(kCacheLineSize) WaitPoint {
+    twist::stdlike::atomic<uint32_t> epoch{0};
+    twist::stdlike::atomic<uint32_t> sleepers{0};
+  };
+
+ public:
+  // Capacity is rounded up to a power of two
+  explicit SpscQueue(size_t capacity)
+      : capacity_(std::bit_ceil(std::max<size_t>(capacity, 1))),
+        buffer_(std::make_unique<Storage[]>(capacity_)) {
+  }
+
+  ~SpscQueue() {
+    const size_t tail = tail_.load();
+    for (size_t pos = head_.load(); pos != tail; ++pos) {
+      At(pos).~T();
+    }
+  }
+
+  // Non-copyable
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // Producer side
+
+  // Inserts the specified element into this queue,
+  // waiting if necessary for space to become available
+  void Push(T value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    WaitForSpace(tail);
+    new (&buffer_[tail & (capacity_ - 1)]) T(std::move(value));
+    Publish(tail_, tail + 1, not_empty_);
+  }
+
+  // Moves from value only on success
+  bool TryPush(T& value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (!HasSpace(tail)) {
+      return false;
+    }
+    new (&buffer_[tail & (capacity_ - 1)]) T(std::move(value));
+    Publish(tail_, tail + 1, not_empty_);
+    return true;
+  }
+
+  // Inserts all elements of [first, last), waiting for space as needed
+  // Every chunk that fits is published with a single index update
+  template <typename Iterator>
+  void PushN(Iterator first, Iterator last) {
+    while (first != last) {
+      const size_t tail = tail_.load(std::memory_order_relaxed);
+      WaitForSpace(tail);
+
+      size_t pos = tail;
+      const size_t end = cached_head_ + capacity_;
+      for (; pos != end && first != last; ++pos, ++first) {
+        new (&buffer_[pos & (capacity_ - 1)]) T(std::move(*first));
+      }
+      Publish(tail_, pos, not_empty_);
+    }
+  }
+
+  // Consumer side
+
+  // Retrieves and removes the head of this queue,
+  // waiting if necessary until an element becomes available
+  T Pop() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    WaitForElements(head);
+    return TakeAt(head);
+  }
+
+  std::optional<T> TryPop() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (!HasElements(head)) {
+      return std::nullopt;
+    }
+    return TakeAt(head);
+  }
+
+  // Retrieves up to max elements into out, waiting until at least one
+  // is available. Returns the number of elements retrieved
+  template <typename OutputIterator>
+  size_t PopN(OutputIterator out, size_t max) {
+    if (max == 0) {
+      return 0;
+    }
+
+    const size_t head = head_.load(std::memory_order_relaxed);
+    WaitForElements(head);
+
+    const size_t count = std::min(cached_tail_ - head, max);
+    for (size_t pos = head; pos != head + count; ++pos, ++out) {
+      T& value = At(pos);
+      *out = std::move(value);
+      value.~T();
+    }
+    Publish(head_, head + count, not_full_);
+    return count;
+  }
+
+ private:
+  T& At(size_t pos) {
+    return *std::launder(
+        reinterpret_cast<T*>(&buffer_[pos & (capacity_ - 1)]));
+  }
+
+  T TakeAt(size_t head) {
+    T& slot = At(head);
+    T value = std::move(slot);
+    slot.~T();
+    Publish(head_, head + 1, not_full_);
+    return value;
+  }
+
+  bool HasSpace(size_t tail) {
+    if (tail - cached_head_ < capacity_) {
+      return true;
+    }
+    cached_head_ = head_.load(std::memory_order_acquire);
+    return tail - cached_head_ < capacity_;
+  }
+
+  bool HasElements(size_t head) {
+    if (head != cached_tail_) {
+      return true;
+    }
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    return head != cached_tail_;
+  }
+
+  void WaitForSpace(size_t tail) {
+    twist::util::SpinWait spin_wait;
+    for (size_t i = 0; !HasSpace(tail); ++i) {
+      if (i < kSpinLimit) {
+        spin_wait();
+      } else {
+        Park(not_full_, [&] {
+          cached_head_ = head_.load();
+          return tail - cached_head_ < capacity_;
+        });
+      }
+    }
+  }
+
+  void WaitForElements(size_t head) {
+    twist::util::SpinWait spin_wait;
+    for (size_t i = 0; !HasElements(head); ++i) {
+      if (i < kSpinLimit) {
+        spin_wait();
+      } else {
+        Park(not_empty_, [&] {
+          cached_tail_ = tail_.load();
+          return head != cached_tail_;
+        });
+      }
+    }
+  }
+
+  template <typename Ready>
+  static void Park(WaitPoint& point, Ready ready) {
+    uint32_t epoch = point.epoch.load();
+    point.sleepers.fetch_add(1);
+    // Re-check (with a seq_cst load) after announcing ourselves,
+    // pairs with Publish
+    if (!ready()) {
+      point.epoch.FutexWait(epoch);
+    }
+    point.sleepers.fetch_sub(1);
+  }
+
+  // seq_cst store orders the index update before the sleepers check,
+  // otherwise the other side could park right after we looked
+  static void Publish(twist::stdlike::atomic<size_t>& index, size_t value,
+                      WaitPoint& other_side) {
+    index.store(value);
+    if (other_side.sleepers.load() > 0) {
+      other_side.epoch.fetch_add(1);
+      other_side.epoch.FutexWakeOne();
+    }
+  }
+
+ private:
+  const size_t capacity_;
+  std::unique_ptr<Storage[]> buffer_;
+
+  // Producer
+  alignas(kCacheLineSize) twist::stdlike::atomic<size_t> tail_{0};
+  size_t cached_head_{0};
+
+  // Consumer
+  alignas(kCacheLineSize) twist::stdlike::atomic<size_t> head_{0};
+  size_t cached_tail_{0};
+
+  WaitPoint not_full_;
+  WaitPoint not_empty_;
+};
+
+}  // namespace solutions
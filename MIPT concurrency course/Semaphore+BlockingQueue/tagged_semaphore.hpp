@@ -0,0 +1,97 @@
+#pragma once
+
+#include "semaphore.hpp"
+
+#include <cassert>
+#include <optional>
+
+namespace solutions {
+
+// Semaphore that hands out typed tokens: a permit acquired from one
+// semaphore can be released only to a semaphore with the same Tag
+
+template <class Tag>
+class TaggedSemaphore {
+ public:
+  // Linear type: must be released exactly once
+  class Token {
+    friend class TaggedSemaphore;
+
+   public:
+    ~Token() {
+      assert(!valid_ && "Token leak");
+    }
+
+    // Non-copyable
+    Token(const Token&) = delete;
+    Token& operator=(const Token&) = delete;
+
+    // Movable
+    Token(Token&& that) {
+      that.Invalidate();
+    }
+
+    Token& operator=(Token&&) = delete;
+
+   private:
+    Token() = default;
+
+    void Invalidate() {
+      assert(valid_ && "Invalid token");
+      valid_ = false;
+    }
+
+   private:
+    bool valid_{true};
+  };
+
+  // Holds a token for the duration of a scope
+  class Guard {
+   public:
+    explicit Guard(TaggedSemaphore& host)
+        : host_(host), token_(host.Acquire()) {
+    }
+
+    // Non-copyable
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard() {
+      host_.Release(std::move(token_));
+    }
+
+   private:
+    TaggedSemaphore& host_;
+    Token token_;
+  };
+
+ public:
+  explicit TaggedSemaphore(size_t tokens) : impl_(tokens) {
+  }
+
+  Token Acquire() {
+    impl_.Acquire();
+    return Token{};
+  }
+
+  std::optional<Token> TryAcquire() {
+    if (impl_.TryAcquire()) {
+      return Token{};
+    }
+    return std::nullopt;
+  }
+
+  void Release(Token&& token) {
+    token.Invalidate();
+    impl_.Release();
+  }
+
+  Guard MakeGuard() {
+    return Guard{*this};
+  }
+
+ private:
+  Semaphore impl_;
+};
+
+}  // namespace solutions
@@ -0,0 +1,119 @@
+#include "../blocking_queue.hpp"
+#include "../channel.hpp"
+#include "../lock_free_blocking_queue.hpp"
+#include "../spsc_queue.hpp"
+
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Bounded queues under equal numbers of producers and consumers,
+// SpscQueue runs with a single pair only
+
+// Every item is its own Put timestamp, so consumers measure
+// the latency from Put to Take
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kThreadCounts[] = {2, 4, 8, 16, 32, 64};
+static const size_t kCapacity = 1024;
+static const size_t kItemsPerProducer = 50000;
+
+static uint64_t NowNanos() {
+  return Clock::now().time_since_epoch() / std::chrono::nanoseconds(1);
+}
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+template <typename Queue, typename Put, typename Take>
+void Run(const char* name, size_t threads, Put put, Take take) {
+  Queue queue{kCapacity};
+
+  const size_t pairs = threads / 2;
+  std::vector<std::vector<uint64_t>> latencies(pairs);
+
+  auto start = Clock::now();
+
+  std::vector<twist::stdlike::thread> workers;
+  for (size_t i = 0; i < pairs; ++i) {
+    workers.emplace_back([&] {
+      for (size_t j = 0; j < kItemsPerProducer; ++j) {
+        put(queue, NowNanos());
+      }
+    });
+    // Every consumer takes as many items as a producer puts
+    workers.emplace_back([&, i] {
+      auto& local = latencies[i];
+      local.reserve(kItemsPerProducer);
+      for (size_t j = 0; j < kItemsPerProducer; ++j) {
+        uint64_t put_at = take(queue);
+        local.push_back(NowNanos() - put_at);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<uint64_t> all;
+  for (auto& local : latencies) {
+    all.insert(all.end(), local.begin(), local.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  std::printf("%-22s threads=%-3zu items/s=%-11.0f put->take ns: p50=%-9lu "
+              "p99=%lu\n",
+              name, threads, all.size() / seconds, Percentile(all, 0.5),
+              Percentile(all, 0.99));
+}
+
+int main() {
+  for (size_t threads : kThreadCounts) {
+    Run<solutions::BlockingQueue<uint64_t>>(
+        "BlockingQueue", threads,
+        [](auto& queue, uint64_t value) {
+          queue.Put(value);
+        },
+        [](auto& queue) {
+          return queue.Take();
+        });
+
+    Run<solutions::LockFreeBlockingQueue<uint64_t>>(
+        "LockFreeBlockingQueue", threads,
+        [](auto& queue, uint64_t value) {
+          queue.Put(value);
+        },
+        [](auto& queue) {
+          return queue.Take();
+        });
+
+    Run<solutions::Channel<uint64_t>>(
+        "Channel", threads,
+        [](auto& queue, uint64_t value) {
+          queue.Send(value);
+        },
+        [](auto& queue) {
+          return *queue.Recv();
+        });
+
+    if (threads == 2) {
+      Run<solutions::SpscQueue<uint64_t>>(
+          "SpscQueue", threads,
+          [](auto& queue, uint64_t value) {
+            queue.Push(value);
+          },
+          [](auto& queue) {
+            return queue.Pop();
+          });
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include "../semaphore.hpp"
+
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Threads compete for a few permits: Acquire, a short critical
+// section, Release. Latency is the time spent in Acquire
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kThreadCounts[] = {2, 4, 8, 16, 32, 64};
+static const size_t kPermitCounts[] = {1, 4};
+static const size_t kOpsPerThread = 20000;
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+void Run(size_t permits, size_t threads) {
+  solutions::Semaphore semaphore{permits};
+
+  std::vector<std::vector<uint64_t>> latencies(threads);
+
+  auto start = Clock::now();
+
+  std::vector<twist::stdlike::thread> workers;
+  for (size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&, i] {
+      auto& local = latencies[i];
+      local.reserve(kOpsPerThread);
+      for (size_t j = 0; j < kOpsPerThread; ++j) {
+        auto begin = Clock::now();
+        semaphore.Acquire();
+        local.push_back((Clock::now() - begin) / std::chrono::nanoseconds(1));
+        semaphore.Release();
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<uint64_t> all;
+  for (auto& local : latencies) {
+    all.insert(all.end(), local.begin(), local.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  std::printf("Semaphore permits=%zu threads=%-3zu ops/s=%-11.0f acquire ns: "
+              "p50=%-8lu p99=%lu\n",
+              permits, threads, all.size() / seconds, Percentile(all, 0.5),
+              Percentile(all, 0.99));
+}
+
+int main() {
+  for (size_t permits : kPermitCounts) {
+    for (size_t threads : kThreadCounts) {
+      Run(permits, threads);
+    }
+  }
+  return 0;
+}
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <twist/stdlike/atomic.hpp>
 #include <twist/stdlike/mutex.hpp>
 #include <twist/stdlike/condition_variable.hpp>
 
+#include <algorithm>
 #include <optional>
 #include <deque>
+#include <vector>
 
 namespace tp {
 
@@ -20,6 +23,7 @@ class UnboundedBlockingQueue {
       return false;
     } else {
       buffer_.push_back(std::move(value));
+      UpdateSize();
       if (waiting_ > 0) {
         can_take_.notify_one();
       }
@@ -27,6 +31,27 @@ class UnboundedBlockingQueue {
     }
   }
 
+  // Inserts all values from range under a single lock acquisition
+  template <typename Range>
+  bool PutBatch(Range&& values) {
+    std::lock_guard guard(mutex_);
+
+    if (closed_) {
+      return false;
+    }
+
+    size_t count = 0;
+    for (auto& value : values) {
+      buffer_.push_back(std::move(value));
+      ++count;
+    }
+    UpdateSize();
+    for (size_t i = 0; i < std::min(count, waiting_); ++i) {
+      can_take_.notify_one();
+    }
+    return true;
+  }
+
   std::optional<T> Take() {
     std::unique_lock guard(mutex_);
 
@@ -42,9 +67,45 @@ class UnboundedBlockingQueue {
 
     T value = std::move(buffer_.front());
     buffer_.pop_front();
+    UpdateSize();
     return value;
   }
 
+  // Non-blocking version of Take
+  std::optional<T> TryTake() {
+    std::lock_guard guard(mutex_);
+
+    if (buffer_.empty()) {
+      return std::nullopt;
+    }
+
+    T value = std::move(buffer_.front());
+    buffer_.pop_front();
+    UpdateSize();
+    return value;
+  }
+
+  // Retrieves up to max values under a single lock acquisition,
+  // does not wait for values to appear
+  std::vector<T> TryTakeBatch(size_t max) {
+    std::lock_guard guard(mutex_);
+
+    std::vector<T> batch;
+    batch.reserve(std::min(max, buffer_.size()));
+    while (!buffer_.empty() && batch.size() < max) {
+      batch.push_back(std::move(buffer_.front()));
+      buffer_.pop_front();
+    }
+    UpdateSize();
+    return batch;
+  }
+
+  // Lock-free emptiness check, lets consumers skip empty queues
+  // without touching the mutex
+  bool IsEmpty() const {
+    return size_.load() == 0;
+  }
+
   void Close() {
     CloseImpl(/*clear=*/false);
   }
@@ -54,11 +115,16 @@ class UnboundedBlockingQueue {
   }
 
  private:
+  void UpdateSize() {
+    size_.store(buffer_.size());
+  }
+
   void CloseImpl(bool clear) {
     std::lock_guard guard(mutex_);
     closed_ = true;
     if (clear) {
       buffer_.clear();
+      UpdateSize();
     }
     can_take_.notify_all();
   }
@@ -67,6 +133,7 @@ class UnboundedBlockingQueue {
   bool closed_{false};    //  guarded by mutex_
   std::deque<T> buffer_;  //  guarded by mutex_
   size_t waiting_{0};     //  guarded by mutex_
+  twist::stdlike::atomic<size_t> size_{0};  // Written under mutex_
   twist::stdlike::mutex mutex_;
   twist::stdlike::condition_variable can_take_;
 };
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/mutex.hpp>
+#include <twist/util/thread_local.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace tp::detail {
+
+// Hazard pointers (M. Michael) for lock-free data structures
+
+// A thread publishes the pointers it is about to dereference in its
+// hazard slots, retired objects are deleted only when no slot holds them.
+// Every thread owns a record with kSlots slots and its retired list,
+// records live until exit and are reused by later threads. Retired objects
+// are scanned in batches proportional to the number of slots,
+// so reclamation is amortized O(1)
+
+// Records are found through twist::util::ThreadLocalPtr, so every
+// (simulated) thread gets its own one. A record is handed over to later
+// threads when its OS thread exits, records of simulated threads
+// are freed with the rest at program exit
+
+class HazardPointers {
+ public:
+  static const size_t kSlots = 2;
+
+  // Publishes the current value of source in the given slot
+  // Returned pointer is safe to dereference until the slot is cleared
+  template <typename T>
+  static T* Protect(size_t slot, const twist::stdlike::atomic<T*>& source) {
+    auto& hazard = Local().slots[slot];
+    T* ptr = source.load();
+    while (true) {
+      hazard.store(ptr);
+      // Re-read: object may have been retired before we published it
+      T* current = source.load();
+      if (current == ptr) {
+        return ptr;
+      }
+      ptr = current;
+    }
+  }
+
+  static void Clear(size_t slot) {
+    Local().slots[slot].store(nullptr);
+  }
+
+  // Deletes object once no thread protects it
+  template <typename T>
+  static void Retire(T* object) {
+    Record& local = Local();
+    local.retired.push_back({object, [](void* ptr) {
+                               delete static_cast<T*>(ptr);
+                             }});
+    if (local.retired.size() >= Instance().ScanThreshold()) {
+      Instance().Scan(local.retired);
+    }
+  }
+
+ private:
+  struct Retired {
+    void* object;
+    void (*deleter)(void*);
+  };
+
+  struct Record {
+    twist::stdlike::atomic<void*> slots[kSlots];
+    twist::stdlike::atomic<bool> in_use{true};
+    Record* next{nullptr};
+
+    std::vector<Retired> retired;  // accessed only by the owner
+  };
+
+  // Releases the record of the current OS thread on its exit
+  struct ExitGuard {
+    ~ExitGuard() {
+      Instance().Release(record);
+    }
+
+    Record* record;
+  };
+
+  ~HazardPointers() {
+    for (auto& object : orphans_) {
+      object.deleter(object.object);
+    }
+    while (Record* record = records_.load()) {
+      records_.store(record->next);
+      for (auto& object : record->retired) {
+        object.deleter(object.object);
+      }
+      delete record;
+    }
+  }
+
+  static HazardPointers& Instance() {
+    static HazardPointers instance;
+    return instance;
+  }
+
+  static Record& Local() {
+    static twist::util::ThreadLocalPtr<Record> record;
+    if (record == nullptr) {
+      record = Instance().AcquireRecord();
+      static thread_local ExitGuard guard{record};
+    }
+    return *record;
+  }
+
+  Record* AcquireRecord() {
+    // Reuse a record released by a finished thread
+    for (Record* record = records_.load(); record != nullptr;
+         record = record->next) {
+      bool in_use = false;
+      if (record->in_use.compare_exchange_strong(in_use, true)) {
+        return record;
+      }
+    }
+
+    auto* record = new Record{};
+    for (auto& slot : record->slots) {
+      slot.store(nullptr);
+    }
+    record->next = records_.load();
+    while (!records_.compare_exchange_weak(record->next, record)) {
+    }
+    record_count_.fetch_add(1);
+    return record;
+  }
+
+  void Release(Record* record) {
+    for (auto& slot : record->slots) {
+      slot.store(nullptr);
+    }
+    Scan(record->retired);
+    Orphan(std::move(record->retired));
+    record->retired.clear();
+    record->in_use.store(false);
+  }
+
+  size_t ScanThreshold() const {
+    return 2 * kSlots * record_count_.load() + 16;
+  }
+
+  void Scan(std::vector<Retired>& retired) {
+    // Adopt objects left behind by finished threads
+    {
+      std::lock_guard guard(orphans_mutex_);
+      retired.insert(retired.end(), orphans_.begin(), orphans_.end());
+      orphans_.clear();
+    }
+
+    std::vector<void*> hazards;
+    for (Record* record = records_.load(); record != nullptr;
+         record = record->next) {
+      for (auto& slot : record->slots) {
+        if (void* ptr = slot.load()) {
+          hazards.push_back(ptr);
+        }
+      }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    size_t kept = 0;
+    for (auto& object : retired) {
+      if (std::binary_search(hazards.begin(), hazards.end(), object.object)) {
+        retired[kept++] = object;
+      } else {
+        object.deleter(object.object);
+      }
+    }
+    retired.resize(kept);
+  }
+
+  void Orphan(std::vector<Retired> retired) {
+    std::lock_guard guard(orphans_mutex_);
+    orphans_.insert(orphans_.end(), retired.begin(), retired.end());
+  }
+
+ private:
+  // Push-only list
+  twist::stdlike::atomic<Record*> records_{nullptr};
+  twist::stdlike::atomic<size_t> record_count_{0};
+
+  std::vector<Retired> orphans_;  // guarded by orphans_mutex_
+  twist::stdlike::mutex orphans_mutex_;
+};
+
+}  // namespace tp::detail
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <tp/hazard_pointers.hpp>
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/util/spin_wait.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace tp {
+
+// Unbounded lock-free multi-producers/multi-consumers queue
+// with the Put/Take/TryTake/Close/Cancel contract of UnboundedBlockingQueue
+
+// Linked list of nodes with a dummy head (M. Michael, M. Scott),
+// dequeued nodes are reclaimed with hazard pointers.
+// Consumers park on a futex only when the queue is empty
+
+template <typename T>
+class LockFreeUnboundedQueue {
+  static const size_t kCacheLineSize = 64;
+
+  struct Node {
+    twist::stdlike::atomic<Node*> next{nullptr};
+    std::optional<T> value;
+  };
+
+  // Hazard slots
+  static const size_t kHead = 0;
+  static const size_t kNext = 1;
+
+  // state_ layout: closed bit + number of Put calls in progress
+  static const uint64_t kClosed = 1;
+  static const uint64_t kPutter = 2;
+
+ public:
+  LockFreeUnboundedQueue() {
+    Node* dummy = new Node{};
+    head_.store(dummy);
+    tail_.store(dummy);
+  }
+
+  ~LockFreeUnboundedQueue() {
+    Node* node = head_.load();
+    while (node != nullptr) {
+      delete std::exchange(node, node->next.load());
+    }
+  }
+
+  // Non-copyable
+  LockFreeUnboundedQueue(const LockFreeUnboundedQueue&) = delete;
+  LockFreeUnboundedQueue& operator=(const LockFreeUnboundedQueue&) = delete;
+
+  // Returns false if queue is closed
+  bool Put(T value) {
+    // Announce ourselves, so that Take does not report
+    // a closed queue as drained while we are linking
+    if (state_.fetch_add(kPutter) & kClosed) {
+      FinishPut();
+      return false;
+    }
+
+    Node* node = new Node{};
+    node->value.emplace(std::move(value));
+    Link(node);
+
+    FinishPut();
+    WakeConsumers(/*all=*/false);
+    return true;
+  }
+
+  // Waits until a value becomes available,
+  // returns nullopt if queue is closed and drained
+  std::optional<T> Take() {
+    while (true) {
+      if (auto value = TryTake()) {
+        return value;
+      }
+
+      uint32_t epoch = not_empty_.load();
+      sleepers_.fetch_add(1);
+      // Re-check after announcing ourselves, pairs with WakeConsumers
+      auto value = TryTake();
+      if (!value.has_value() && !IsDrained()) {
+        not_empty_.FutexWait(epoch);
+      }
+      sleepers_.fetch_sub(1);
+
+      if (value.has_value()) {
+        return value;
+      }
+      if (IsDrained()) {
+        return TryTake();  // Put may have finished right before close
+      }
+    }
+  }
+
+  // Non-blocking version of Take
+  std::optional<T> TryTake() {
+    while (true) {
+      Node* head = detail::HazardPointers::Protect(kHead, head_);
+      Node* next = detail::HazardPointers::Protect(kNext, head->next);
+      if (head != head_.load()) {
+        continue;
+      }
+
+      if (next == nullptr) {
+        detail::HazardPointers::Clear(kHead);
+        detail::HazardPointers::Clear(kNext);
+        return std::nullopt;
+      }
+
+      Node* tail = tail_.load();
+      if (head == tail) {
+        // Tail is lagging behind, help the producer
+        tail_.compare_exchange_strong(tail, next);
+        continue;
+      }
+
+      if (head_.compare_exchange_strong(head, next)) {
+        // next is the new dummy: its value belongs to us,
+        // and the node stays alive while it is protected
+        std::optional<T> value = std::move(next->value);
+        next->value.reset();
+        detail::HazardPointers::Clear(kHead);
+        detail::HazardPointers::Clear(kNext);
+        detail::HazardPointers::Retire(head);
+        return value;
+      }
+    }
+  }
+
+  bool IsEmpty() const {
+    Node* head = detail::HazardPointers::Protect(kHead, head_);
+    const bool empty = head->next.load() == nullptr;
+    detail::HazardPointers::Clear(kHead);
+    return empty;
+  }
+
+  void Close() {
+    state_.fetch_or(kClosed);
+    WakeConsumers(/*all=*/true);
+  }
+
+  // Closes the queue and discards pending values
+  void Cancel() {
+    Close();
+
+    // Putters that had passed the closed check still link their values
+    twist::util::SpinWait spin_wait;
+    while (true) {
+      while (TryTake().has_value()) {
+      }
+      if (IsDrained()) {
+        break;
+      }
+      spin_wait();
+    }
+  }
+
+ private:
+  void Link(Node* node) {
+    while (true) {
+      Node* tail = detail::HazardPointers::Protect(kHead, tail_);
+      Node* next = tail->next.load();
+      if (tail != tail_.load()) {
+        continue;
+      }
+
+      if (next != nullptr) {
+        // Tail is lagging behind, help the other producer
+        tail_.compare_exchange_strong(tail, next);
+        continue;
+      }
+
+      Node* expected = nullptr;
+      if (tail->next.compare_exchange_strong(expected, node)) {
+        tail_.compare_exchange_strong(tail, node);
+        detail::HazardPointers::Clear(kHead);
+        return;
+      }
+    }
+  }
+
+  void FinishPut() {
+    if (state_.fetch_sub(kPutter) == (kClosed | kPutter)) {
+      // Last putter after Close: consumers waiting for it may report drained
+      WakeConsumers(/*all=*/true);
+    }
+  }
+
+  // Closed, no Put in progress and nothing left
+  bool IsDrained() const {
+    return state_.load() == kClosed && IsEmpty();
+  }
+
+  void WakeConsumers(bool all) {
+    if (sleepers_.load() > 0) {
+      not_empty_.fetch_add(1);
+      if (all) {
+        not_empty_.FutexWakeAll();
+      } else {
+        not_empty_.FutexWakeOne();
+      }
+    }
+  }
+
+ private:
+  alignas(kCacheLineSize) twist::stdlike::atomic<Node*> head_{nullptr};
+  alignas(kCacheLineSize) twist::stdlike::atomic<Node*> tail_{nullptr};
+
+  alignas(kCacheLineSize) twist::stdlike::atomic<uint64_t> state_{0};
+
+  // Parking
+  alignas(kCacheLineSize) twist::stdlike::atomic<uint32_t> not_empty_{0};
+  twist::stdlike::atomic<uint32_t> sleepers_{0};
+};
+
+}  // namespace tp
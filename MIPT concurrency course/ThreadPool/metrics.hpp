@@ -0,0 +1,207 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Define TP_ENABLE_METRICS to collect per-worker counters. Without it
+// ThreadPool::Stats() reports zeros and workers never read the clock
+// (unless TP_ENABLE_TRACE needs timestamps)
+
+namespace tp {
+
+// Log2-bucketed histogram of durations in nanoseconds:
+// bucket i counts values in [2^(i-1), 2^i)
+
+struct Histogram {
+  static const size_t kBuckets = 64;
+
+  static size_t BucketOf(uint64_t value) {
+    return std::min<size_t>(std::bit_width(value), kBuckets - 1);
+  }
+
+  uint64_t Count() const {
+    uint64_t count = 0;
+    for (uint64_t bucket : buckets) {
+      count += bucket;
+    }
+    return count;
+  }
+
+  // Upper bound of the bucket holding the p-th quantile, p in [0, 1]
+  uint64_t Percentile(double p) const {
+    const uint64_t total = Count();
+    if (total == 0) {
+      return 0;
+    }
+    const auto rank = static_cast<uint64_t>(p * (total - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        return i == 0 ? 0 : uint64_t{1} << i;
+      }
+    }
+    return UINT64_MAX;
+  }
+
+  void Merge(const Histogram& that) {
+    for (size_t i = 0; i < kBuckets; ++i) {
+      buckets[i] += that.buckets[i];
+    }
+  }
+
+  std::array<uint64_t, kBuckets> buckets{};
+};
+
+struct WorkerStats {
+  uint64_t tasks_executed = 0;
+  uint64_t busy_ns = 0;
+  uint64_t parked_ns = 0;
+  uint64_t steal_attempts = 0;
+  uint64_t steals = 0;
+  // Max number of tasks observed in the worker's local deque,
+  // shared queues are not counted
+  uint64_t local_queue_high_water = 0;
+
+  Histogram queue_latency;  // Submit -> start
+  Histogram run_time;       // Start -> finish
+
+  void Merge(const WorkerStats& that) {
+    tasks_executed += that.tasks_executed;
+    busy_ns += that.busy_ns;
+    parked_ns += that.parked_ns;
+    steal_attempts += that.steal_attempts;
+    steals += that.steals;
+    local_queue_high_water =
+        std::max(local_queue_high_water, that.local_queue_high_water);
+    queue_latency.Merge(that.queue_latency);
+    run_time.Merge(that.run_time);
+  }
+};
+
+struct PoolStats {
+  std::vector<WorkerStats> workers;
+
+  WorkerStats Total() const {
+    WorkerStats total;
+    for (const auto& stats : workers) {
+      total.Merge(stats);
+    }
+    return total;
+  }
+};
+
+namespace detail {
+
+inline uint64_t NowNanos() {
+#if defined(TP_ENABLE_METRICS) || defined(TP_ENABLE_TRACE)
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+#else
+  return 0;
+#endif
+}
+
+// Per-worker counters
+
+// Written only by the owning worker, so updates are plain
+// relaxed load + store instead of read-modify-write.
+// Stats() may read them concurrently and sees a slightly stale snapshot
+
+class WorkerMetrics {
+  using Counter = twist::stdlike::atomic<uint64_t>;
+
+ public:
+  void TaskCompleted(uint64_t submitted_at, uint64_t started_at,
+                     uint64_t finished_at) {
+#if defined(TP_ENABLE_METRICS)
+    // Clocks of different threads may disagree slightly
+    const uint64_t waited =
+        started_at > submitted_at ? started_at - submitted_at : 0;
+    const uint64_t ran = finished_at - started_at;
+
+    Bump(tasks_executed_);
+    Bump(busy_ns_, ran);
+    Bump(queue_latency_[Histogram::BucketOf(waited)]);
+    Bump(run_time_[Histogram::BucketOf(ran)]);
+#else
+    (void)submitted_at;
+    (void)started_at;
+    (void)finished_at;
+#endif
+  }
+
+  void Parked(uint64_t ns) {
+#if defined(TP_ENABLE_METRICS)
+    Bump(parked_ns_, ns);
+#else
+    (void)ns;
+#endif
+  }
+
+  void StealAttempt(bool success) {
+#if defined(TP_ENABLE_METRICS)
+    Bump(steal_attempts_);
+    if (success) {
+      Bump(steals_);
+    }
+#else
+    (void)success;
+#endif
+  }
+
+  void LocalQueueDepth(size_t depth) {
+#if defined(TP_ENABLE_METRICS)
+    if (depth > local_queue_high_water_.load(std::memory_order_relaxed)) {
+      local_queue_high_water_.store(depth, std::memory_order_relaxed);
+    }
+#else
+    (void)depth;
+#endif
+  }
+
+  WorkerStats Snapshot() const {
+    WorkerStats stats;
+    stats.tasks_executed = Read(tasks_executed_);
+    stats.busy_ns = Read(busy_ns_);
+    stats.parked_ns = Read(parked_ns_);
+    stats.steal_attempts = Read(steal_attempts_);
+    stats.steals = Read(steals_);
+    stats.local_queue_high_water = Read(local_queue_high_water_);
+    for (size_t i = 0; i < Histogram::kBuckets; ++i) {
+      stats.queue_latency.buckets[i] = Read(queue_latency_[i]);
+      stats.run_time.buckets[i] = Read(run_time_[i]);
+    }
+    return stats;
+  }
+
+ private:
+  static void Bump(Counter& counter, uint64_t delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta,
+                  std::memory_order_relaxed);
+  }
+
+  static uint64_t Read(const Counter& counter) {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+ private:
+  Counter tasks_executed_{0};
+  Counter busy_ns_{0};
+  Counter parked_ns_{0};
+  Counter steal_attempts_{0};
+  Counter steals_{0};
+  Counter local_queue_high_water_{0};
+  std::array<Counter, Histogram::kBuckets> queue_latency_{};
+  std::array<Counter, Histogram::kBuckets> run_time_{};
+};
+
+}  // namespace detail
+
+}  // namespace tp
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace tp {
+
+// Where worker threads run
+
+struct Placement {
+  // Pin each worker to its own core (round-robin if there are
+  // more workers than cores)
+  bool pin_workers = false;
+
+  // Spread workers evenly over NUMA nodes, give each node its own
+  // queue for SubmitOn, steal within the node before going remote
+  bool numa_aware = false;
+};
+
+}  // namespace tp
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace tp {
+
+// Priority lanes, lower value is served first
+enum class Priority : size_t {
+  High = 0,
+  Normal = 1,
+  Low = 2,
+};
+
+static const size_t kPriorityLanes = 3;
+
+// How workers choose between non-empty lanes
+enum class PickPolicy {
+  // Lower priority runs only when higher lanes are empty
+  Strict,
+  // High : Normal : Low get 4 : 2 : 1 of picks, so low lanes never starve
+  Weighted,
+};
+
+using Clock = std::chrono::steady_clock;
+using Deadline = Clock::time_point;
+
+}  // namespace tp
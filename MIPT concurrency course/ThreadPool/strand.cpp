@@ -0,0 +1,74 @@
+#include <tp/strand.hpp>
+
+#include <twist/util/spin_wait.hpp>
+
+#include <utility>
+
+namespace tp {
+
+Strand::Strand(ThreadPool& pool) : pool_(pool) {
+}
+
+void Strand::Submit(Task task) {
+  Submit(new TaskNode(std::move(task)));
+}
+
+void Strand::Submit(TaskBase* task) {
+  bool idle = pending_.fetch_add(1) == 0;
+  Push(task);
+  if (idle) {
+    ScheduleBatch();
+  }
+}
+
+void Strand::TaskNode::Run() {
+  Task task = std::move(this->task);
+  delete this;
+  task();
+}
+
+void Strand::Push(TaskBase* task) {
+  task->next = head_.load();
+  while (!head_.compare_exchange_weak(task->next, task)) {
+  }
+}
+
+void Strand::ScheduleBatch() {
+  pool_.Submit([this] {
+    RunBatch();
+  });
+}
+
+void Strand::RunBatch() {
+  // Batch is scheduled only for counted tasks, but a submitter
+  // counts its task before it pushes it: wait for the push
+  TaskBase* head;
+  twist::util::SpinWait spin_wait;
+  while ((head = head_.exchange(nullptr)) == nullptr) {
+    spin_wait();
+  }
+
+  // Take everything queued so far and restore FIFO order
+  TaskBase* batch = nullptr;
+  for (TaskBase* task = head; task != nullptr;) {
+    TaskBase* next = task->next;
+    task->next = batch;
+    batch = task;
+    task = next;
+  }
+
+  size_t completed = 0;
+  while (batch != nullptr) {
+    // Task may be destroyed by Run
+    TaskBase* task = std::exchange(batch, batch->next);
+    detail::RunTask(task);
+    ++completed;
+  }
+
+  // Someone counted a task we have not run yet: go on in a new batch
+  if (pending_.fetch_sub(completed) != completed) {
+    ScheduleBatch();
+  }
+}
+
+}  // namespace tp
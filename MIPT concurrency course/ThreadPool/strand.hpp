@@ -0,0 +1,58 @@
+#pragma once
+
+#include <tp/thread_pool.hpp>
+#include <tp/task.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include <twist/stdlike/atomic.hpp>
+
+namespace tp {
+
+// Serial executor on top of thread pool
+
+// Tasks submitted to strand run one at a time in FIFO order,
+// possibly in different worker threads. Queued tasks run in batches:
+// one pool task drains everything submitted so far
+
+// Strand must outlive the tasks submitted to it
+
+class Strand {
+ public:
+  explicit Strand(ThreadPool& pool);
+
+  // Non-copyable
+  Strand(const Strand&) = delete;
+  Strand& operator=(const Strand&) = delete;
+
+  void Submit(Task task);
+
+  // Intrusive task is linked as is, without allocations
+  void Submit(TaskBase* task);
+
+ private:
+  // Owns a submitted Task, deletes itself when run
+  struct TaskNode : TaskBase {
+    explicit TaskNode(Task task) : task(std::move(task)) {
+    }
+
+    void Run() override;
+
+    Task task;
+  };
+
+  void Push(TaskBase* task);
+  void ScheduleBatch();
+  void RunBatch();
+
+ private:
+  ThreadPool& pool_;
+  // Lock-free MPSC stack of queued tasks, newest first
+  twist::stdlike::atomic<TaskBase*> head_{nullptr};
+  // Submitted but not yet completed tasks,
+  // the one who moves it from zero schedules a batch
+  twist::stdlike::atomic<size_t> pending_{0};
+};
+
+}  // namespace tp
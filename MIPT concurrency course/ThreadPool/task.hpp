@@ -1,10 +1,215 @@
 #pragma once
 
-#include <wheels/support/function.hpp>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace tp {
 
-using Task = wheels::UniqueFunction<void()>;
+// Intrusive task: embed into your own object and submit
+// with Task(&object) to avoid allocations altogether
+// Run is called exactly once, object must stay alive until then
 
-}  // namespace tp
+struct TaskBase {
+  virtual ~TaskBase() = default;
+
+  virtual void Run() = 0;
+
+  // Intrusive link for executors that queue tasks themselves (Strand)
+  TaskBase* next{nullptr};
+};
+
+// Move-only void() callable
+
+// Closures up to kInlineCapacity bytes are stored inline,
+// so submitting a typical lambda does not touch the heap
+
+class Task {
+ public:
+  static const size_t kInlineCapacity = 64;
+
+ private:
+  struct VTable {
+    void (*invoke)(void* storage);
+    // Move-constructs into dst and destroys src
+    void (*relocate)(void* dst, void* src);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename F>
+  struct InlineStorage {
+    static F& Get(void* storage) {
+      return *std::launder(static_cast<F*>(storage));
+    }
+
+    static void Invoke(void* storage) {
+      Get(storage)();
+    }
+
+    static void Relocate(void* dst, void* src) {
+      new (dst) F(std::move(Get(src)));
+      Get(src).~F();
+    }
+
+    static void Destroy(void* storage) {
+      Get(storage).~F();
+    }
+
+    static constexpr VTable kVTable{Invoke, Relocate, Destroy};
+  };
+
+  // Fallback for large closures
+  template <typename F>
+  struct HeapStorage {
+    static F*& Get(void* storage) {
+      return *static_cast<F**>(storage);
+    }
+
+    static void Invoke(void* storage) {
+      (*Get(storage))();
+    }
+
+    static void Relocate(void* dst, void* src) {
+      new (dst) F*(Get(src));
+    }
+
+    static void Destroy(void* storage) {
+      delete Get(storage);
+    }
+
+    static constexpr VTable kVTable{Invoke, Relocate, Destroy};
+  };
+
+  struct IntrusiveStorage {
+    static TaskBase*& Get(void* storage) {
+      return *static_cast<TaskBase**>(storage);
+    }
+
+    static void Invoke(void* storage) {
+      Get(storage)->Run();
+    }
+
+    static void Relocate(void* dst, void* src) {
+      new (dst) TaskBase*(Get(src));
+    }
+
+    static void Destroy(void*) {
+      // Owned by the caller
+    }
+
+    static constexpr VTable kVTable{Invoke, Relocate, Destroy};
+  };
 
+  template <typename F>
+  static constexpr bool kFitsInline =
+      sizeof(F) <= kInlineCapacity &&
+      alignof(F) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<F>;
+
+ public:
+  Task() = default;
+
+  template <typename F, typename = std::enable_if_t<
+                            !std::is_same_v<std::decay_t<F>, Task> &&
+                            std::is_invocable_r_v<void, std::decay_t<F>&>>>
+  Task(F&& f) {  // NOLINT
+    using Closure = std::decay_t<F>;
+    if constexpr (kFitsInline<Closure>) {
+      new (storage_) Closure(std::forward<F>(f));
+      vtable_ = &InlineStorage<Closure>::kVTable;
+    } else {
+      new (storage_) Closure*(new Closure(std::forward<F>(f)));
+      vtable_ = &HeapStorage<Closure>::kVTable;
+    }
+  }
+
+  explicit Task(TaskBase* task) {
+    new (storage_) TaskBase*(task);
+    vtable_ = &IntrusiveStorage::kVTable;
+  }
+
+  Task(Task&& that) noexcept {
+    MoveFrom(that);
+  }
+
+  Task& operator=(Task&& that) noexcept {
+    if (this != &that) {
+      Reset();
+      MoveFrom(that);
+    }
+    return *this;
+  }
+
+  // Non-copyable
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() {
+    Reset();
+  }
+
+  void operator()() {
+    assert(vtable_ != nullptr);
+    vtable_->invoke(storage_);
+  }
+
+  explicit operator bool() const {
+    return vtable_ != nullptr;
+  }
+
+  // Scheduler bookkeeping for latency metrics, nanoseconds
+  void SetSubmitTime(uint64_t now) {
+    submitted_at_ = now;
+  }
+
+  uint64_t SubmitTime() const {
+    return submitted_at_;
+  }
+
+ private:
+  void MoveFrom(Task& that) {
+    submitted_at_ = that.submitted_at_;
+    if (that.vtable_ != nullptr) {
+      that.vtable_->relocate(storage_, that.storage_);
+      vtable_ = std::exchange(that.vtable_, nullptr);
+    }
+  }
+
+  void Reset() {
+    if (vtable_ != nullptr) {
+      std::exchange(vtable_, nullptr)->destroy(storage_);
+    }
+  }
+
+ private:
+  alignas(std::max_align_t) std::byte storage_[kInlineCapacity];
+  const VTable* vtable_{nullptr};
+  // Fits into the tail padding after vtable_
+  uint64_t submitted_at_{0};
+};
+
+namespace detail {
+
+// Executors swallow exceptions that escape a task
+// and go on with the next one
+
+inline void RunTask(Task& task) noexcept {
+  try {
+    task();
+  } catch (...) {
+  }
+}
+
+inline void RunTask(TaskBase* task) noexcept {
+  try {
+    task->Run();
+  } catch (...) {
+  }
+}
+
+}  // namespace detail
+
+}  // namespace tp
@@ -0,0 +1,73 @@
+#include <tp/thread_pool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// External thread submits bursts of tiny tasks one by one (Submit)
+// or all at once (SubmitBatch), workers drain the shared queue
+// in batches either way
+
+// Latency is measured from the start of the burst submission
+// to the start of the task
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kWorkerCounts[] = {1, 2, 4, 8, 16};
+static const size_t kBurstSize = 1024;
+static const size_t kBursts = 100;
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+void Run(const char* name, size_t workers, bool batched) {
+  tp::ThreadPool pool{workers};
+
+  std::vector<uint64_t> latencies(kBurstSize * kBursts);
+
+  auto start = Clock::now();
+  for (size_t burst = 0; burst < kBursts; ++burst) {
+    uint64_t* slots = &latencies[burst * kBurstSize];
+    auto submitted = Clock::now();
+
+    auto make_task = [slots, submitted](size_t i) {
+      return [slot = slots + i, submitted] {
+        *slot = (Clock::now() - submitted) / std::chrono::nanoseconds(1);
+      };
+    };
+
+    if (batched) {
+      std::vector<tp::Task> tasks;
+      tasks.reserve(kBurstSize);
+      for (size_t i = 0; i < kBurstSize; ++i) {
+        tasks.emplace_back(make_task(i));
+      }
+      pool.SubmitBatch(std::move(tasks));
+    } else {
+      for (size_t i = 0; i < kBurstSize; ++i) {
+        pool.Submit(make_task(i));
+      }
+    }
+    pool.WaitIdle();
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  pool.Stop();
+
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%-12s workers=%-3zu tasks/s=%-11.0f latency ns: p50=%-9lu "
+              "p99=%lu\n",
+              name, workers, latencies.size() / seconds,
+              Percentile(latencies, 0.5), Percentile(latencies, 0.99));
+}
+
+int main() {
+  for (size_t workers : kWorkerCounts) {
+    Run("Submit", workers, /*batched=*/false);
+    Run("SubmitBatch", workers, /*batched=*/true);
+  }
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include <tp/lock_free_queue.hpp>
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/thread.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Several producers and consumers hammer LockFreeUnboundedQueue:
+// nodes are retired and reclaimed by hazard pointers all the time,
+// a node freed too early shows up as a lost/corrupted value
+// (or as a report under a sanitizer)
+
+static const size_t kProducers = 4;
+static const size_t kConsumers = 4;
+static const size_t kValuesPerProducer = 50000;
+
+static void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << std::endl;
+    std::abort();
+  }
+}
+
+void Stress() {
+  tp::LockFreeUnboundedQueue<std::unique_ptr<size_t>> queue;
+
+  twist::stdlike::atomic<size_t> sum{0};
+  twist::stdlike::atomic<size_t> count{0};
+
+  std::vector<twist::stdlike::thread> consumers;
+  for (size_t i = 0; i < kConsumers; ++i) {
+    consumers.emplace_back([&] {
+      while (auto value = queue.Take()) {
+        sum.fetch_add(**value);
+        count.fetch_add(1);
+      }
+    });
+  }
+
+  std::vector<twist::stdlike::thread> producers;
+  for (size_t i = 0; i < kProducers; ++i) {
+    producers.emplace_back([&] {
+      for (size_t j = 1; j <= kValuesPerProducer; ++j) {
+        queue.Put(std::make_unique<size_t>(j));
+      }
+    });
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  queue.Close();
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  const size_t expected_sum =
+      kProducers * kValuesPerProducer * (kValuesPerProducer + 1) / 2;
+  Check(count.load() == kProducers * kValuesPerProducer, "count");
+  Check(sum.load() == expected_sum, "sum");
+  Check(!queue.Put(std::make_unique<size_t>(1)), "Put after Close");
+}
+
+// Close races with Put: every accepted value must be taken
+void CloseRace() {
+  for (size_t round = 0; round < 100; ++round) {
+    tp::LockFreeUnboundedQueue<size_t> queue;
+
+    twist::stdlike::atomic<size_t> accepted{0};
+    twist::stdlike::atomic<size_t> taken{0};
+
+    std::vector<twist::stdlike::thread> threads;
+    for (size_t i = 0; i < 2; ++i) {
+      threads.emplace_back([&] {
+        for (size_t j = 0; j < 1000; ++j) {
+          if (queue.Put(j)) {
+            accepted.fetch_add(1);
+          }
+        }
+      });
+      threads.emplace_back([&] {
+        while (queue.Take().has_value()) {
+          taken.fetch_add(1);
+        }
+      });
+    }
+
+    queue.Close();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    Check(accepted.load() == taken.load(), "accepted == taken");
+  }
+}
+
+void Cancel() {
+  tp::LockFreeUnboundedQueue<std::unique_ptr<size_t>> queue;
+  for (size_t i = 0; i < 1000; ++i) {
+    queue.Put(std::make_unique<size_t>(i));
+  }
+  queue.Cancel();
+  Check(queue.IsEmpty(), "empty after Cancel");
+  Check(!queue.Take().has_value(), "Take after Cancel");
+}
+
+int main() {
+  Stress();
+  CloseRace();
+  Cancel();
+  std::cout << "OK" << std::endl;
+  return 0;
+}
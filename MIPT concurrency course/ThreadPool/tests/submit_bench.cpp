@@ -0,0 +1,119 @@
+#include <tp/thread_pool.hpp>
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Submit throughput of tp::ThreadPool
+
+// External: as many outside threads as workers submit tiny tasks,
+// they all land in the shared queue
+
+// Internal: every task submits its children from inside the pool,
+// they land in the worker's local deque and get stolen
+
+// Latency is measured from Submit to the start of the task
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kWorkerCounts[] = {1, 2, 4, 8, 16, 32, 64};
+static const size_t kTasksPerSubmitter = 20000;
+static const size_t kFanOut = 8;
+static const size_t kDepth = 6;  // 8^6 = 262144 leaves
+
+static uint64_t NowNanos() {
+  return Clock::now().time_since_epoch() / std::chrono::nanoseconds(1);
+}
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+static void Report(const char* name, size_t workers, double seconds,
+                   std::vector<uint64_t>& latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%-9s workers=%-3zu tasks/s=%-11.0f submit->start ns: "
+              "p50=%-9lu p99=%lu\n",
+              name, workers, latencies.size() / seconds,
+              Percentile(latencies, 0.5), Percentile(latencies, 0.99));
+}
+
+void External(size_t workers) {
+  tp::ThreadPool pool{workers};
+
+  // One slot per task, written by the task itself
+  std::vector<uint64_t> latencies(workers * kTasksPerSubmitter);
+
+  auto start = Clock::now();
+
+  std::vector<twist::stdlike::thread> submitters;
+  for (size_t i = 0; i < workers; ++i) {
+    submitters.emplace_back([&, i] {
+      uint64_t* slots = &latencies[i * kTasksPerSubmitter];
+      for (size_t j = 0; j < kTasksPerSubmitter; ++j) {
+        pool.Submit([slot = slots + j, submitted_at = NowNanos()] {
+          *slot = NowNanos() - submitted_at;
+        });
+      }
+    });
+  }
+  for (auto& submitter : submitters) {
+    submitter.join();
+  }
+  pool.WaitIdle();
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  pool.Stop();
+
+  Report("External", workers, seconds, latencies);
+}
+
+struct Tree {
+  tp::ThreadPool& pool;
+  std::vector<uint64_t>& latencies;
+  twist::stdlike::atomic<size_t> next_slot{0};
+
+  void Spawn(size_t depth) {
+    pool.Submit([this, depth, submitted_at = NowNanos()] {
+      latencies[next_slot.fetch_add(1)] = NowNanos() - submitted_at;
+      if (depth > 0) {
+        for (size_t i = 0; i < kFanOut; ++i) {
+          Spawn(depth - 1);
+        }
+      }
+    });
+  }
+};
+
+void Internal(size_t workers) {
+  size_t tasks = 0;
+  for (size_t level = 0, width = 1; level <= kDepth; ++level) {
+    tasks += width;
+    width *= kFanOut;
+  }
+
+  tp::ThreadPool pool{workers};
+  std::vector<uint64_t> latencies(tasks);
+  Tree tree{pool, latencies};
+
+  auto start = Clock::now();
+  tree.Spawn(kDepth);
+  pool.WaitIdle();
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  pool.Stop();
+
+  Report("Internal", workers, seconds, latencies);
+}
+
+int main() {
+  for (size_t workers : kWorkerCounts) {
+    External(workers);
+    Internal(workers);
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include <tp/task.hpp>
+#include <tp/thread_pool.hpp>
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Heap allocations per Submit, counted by a replacement operator new
+
+// Closures that fit into Task::kInlineCapacity are stored inline,
+// larger ones take one allocation, intrusive tasks take none.
+// Whatever is left is the amortized growth of the pool's queues
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kTasks = 100000;
+static const size_t kWorkerCounts[] = {1, 4, 16};
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+struct Counter : tp::TaskBase {
+  void Run() override {
+    done->fetch_add(1);
+  }
+
+  twist::stdlike::atomic<size_t>* done{nullptr};
+};
+
+// Submits kTasks tasks made by make_task from a pool worker,
+// so that they go to its local deque
+template <typename MakeTask>
+void Run(const char* name, size_t workers, MakeTask make_task) {
+  tp::ThreadPool pool{workers};
+  twist::stdlike::atomic<size_t> done{0};
+
+  uint64_t allocated = 0;
+  double seconds = 0;
+  pool.Submit([&] {
+    auto start = Clock::now();
+    uint64_t before = allocations.load();
+    for (size_t i = 0; i < kTasks; ++i) {
+      pool.Submit(make_task(done, i));
+    }
+    allocated = allocations.load() - before;
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  });
+  pool.WaitIdle();
+  pool.Stop();
+
+  std::printf("%-10s workers=%-3zu submits/s=%-11.0f allocations/submit=%.4f\n",
+              name, workers, kTasks / seconds,
+              static_cast<double>(allocated) / kTasks);
+}
+
+int main() {
+  // Allocated up front, not counted
+  std::vector<Counter> intrusive(kTasks);
+
+  for (size_t workers : kWorkerCounts) {
+    Run("Inline", workers, [](auto& done, size_t) {
+      return [&done] {
+        done.fetch_add(1);
+      };
+    });
+
+    Run("Heap", workers, [](auto& done, size_t) {
+      static_assert(sizeof(std::array<char, 128>) > tp::Task::kInlineCapacity);
+      return [&done, payload = std::array<char, 128>{}] {
+        done.fetch_add(payload.size());
+      };
+    });
+
+    Run("Intrusive", workers, [&intrusive](auto& done, size_t i) {
+      intrusive[i].done = &done;
+      return tp::Task(&intrusive[i]);
+    });
+  }
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include <tp/thread_pool.hpp>
+#include <tp/timer_wheel.hpp>
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using tp::detail::TimerLink;
+using tp::detail::TimerWheel;
+
+static void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << std::endl;
+    std::abort();
+  }
+}
+
+static bool Contains(const std::vector<TimerLink*>& timers,
+                     const TimerLink* timer) {
+  return std::find(timers.begin(), timers.end(), timer) != timers.end();
+}
+
+// Every timer expires exactly at its tick, neither early nor late:
+// level boundaries (64, 4096, ... ticks) force cascades
+void WheelBoundaries() {
+  static const uint64_t kStarts[] = {0, 1, 60, 4000, 262100};
+  static const uint64_t kDelays[] = {
+      1,      2,      63,     64,         65,
+      127,    128,    4095,   4096,       4097,
+      8192,   262143, 262144, 262145,     uint64_t{1} << 30,
+      // Beyond the top wheel: overflow list
+      uint64_t{1} << 36, (uint64_t{1} << 36) + 5,
+  };
+
+  for (uint64_t start : kStarts) {
+    for (uint64_t delay : kDelays) {
+      TimerWheel wheel;
+      std::vector<TimerLink*> expired;
+      wheel.Advance(start, expired);
+      Check(expired.empty(), "empty wheel");
+
+      TimerLink timer;
+      timer.expires = start + delay;
+      Check(wheel.Insert(&timer), "insert");
+
+      wheel.Advance(timer.expires - 1, expired);
+      Check(expired.empty(), "timer does not fire early");
+      Check(!wheel.IsEmpty(), "timer is still pending");
+
+      wheel.Advance(timer.expires, expired);
+      Check(expired.size() == 1 && expired[0] == &timer, "timer fires");
+      Check(wheel.IsEmpty(), "wheel is empty");
+    }
+  }
+}
+
+// Many timers, time moves in random steps: each timer is reported
+// by the first Advance that reaches its tick
+void WheelRandom() {
+  static const size_t kTimers = 10000;
+
+  std::mt19937_64 random{42};
+  TimerWheel wheel;
+  std::vector<TimerLink> timers(kTimers);
+  for (auto& timer : timers) {
+    // Spread over every level
+    timer.expires = 1 + random() % (uint64_t{1} << (random() % 40));
+    Check(wheel.Insert(&timer), "insert");
+  }
+
+  size_t fired = 0;
+  std::vector<TimerLink*> expired;
+  while (!wheel.IsEmpty()) {
+    const uint64_t before = wheel.Now();
+    const uint64_t tick = before + 1 + random() % (uint64_t{1} << 20);
+    expired.clear();
+    wheel.Advance(tick, expired);
+    for (TimerLink* timer : expired) {
+      Check(timer->expires > before && timer->expires <= tick,
+            "timer fires on time");
+    }
+    fired += expired.size();
+  }
+  Check(fired == kTimers, "all timers fired");
+}
+
+void WheelRemove() {
+  TimerWheel wheel;
+  TimerLink removed;
+  TimerLink kept;
+  removed.expires = 5000;  // Level 2, cascades on the way down
+  kept.expires = 5000;
+  Check(wheel.Insert(&removed) && wheel.Insert(&kept), "insert");
+
+  std::vector<TimerLink*> expired;
+  wheel.Advance(4096, expired);  // Both have cascaded to level 1
+  wheel.Remove(&removed);
+  Check(!removed.linked, "removed timer is unlinked");
+
+  wheel.Advance(10000, expired);
+  Check(expired.size() == 1 && Contains(expired, &kept),
+        "removed timer does not fire");
+
+  // Due timer is not linked at all
+  TimerLink due;
+  due.expires = wheel.Now();
+  Check(!wheel.Insert(&due), "due timer is rejected");
+
+  TimerLink pending;
+  pending.expires = wheel.Now() + (uint64_t{1} << 40);
+  Check(wheel.Insert(&pending), "insert");
+  std::vector<TimerLink*> drained;
+  wheel.Drain(drained);
+  Check(drained.size() == 1 && wheel.IsEmpty(), "drain");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SubmitAfter() {
+  tp::ThreadPool pool{2};
+
+  twist::stdlike::atomic<bool> done{false};
+  auto start = tp::Clock::now();
+  pool.SubmitAfter(50ms, [&] {
+    Check(tp::Clock::now() - start >= 50ms, "delayed task does not run early");
+    done.store(true);
+  });
+
+  std::this_thread::sleep_for(200ms);
+  Check(done.load(), "delayed task has run");
+  pool.Stop();
+}
+
+void CancelBeforeFire() {
+  tp::ThreadPool pool{2};
+
+  twist::stdlike::atomic<bool> ran{false};
+  auto handle = pool.SubmitAfter(50ms, [&] {
+    ran.store(true);
+  });
+  Check(handle.Cancel(), "cancel pending timer");
+  Check(!handle.Cancel(), "cancel is one-shot");
+
+  std::this_thread::sleep_for(150ms);
+  Check(!ran.load(), "cancelled task does not run");
+  pool.Stop();
+}
+
+void SubmitEvery() {
+  tp::ThreadPool pool{2};
+
+  twist::stdlike::atomic<size_t> runs{0};
+  auto handle = pool.SubmitEvery(10ms, [&] {
+    runs.fetch_add(1);
+  });
+
+  std::this_thread::sleep_for(200ms);
+  Check(handle.Cancel(), "cancel periodic timer");
+  const size_t runs_at_cancel = runs.load();
+  Check(runs_at_cancel >= 3, "periodic task is re-armed");
+
+  // A run may have been on the pool at the moment of Cancel
+  std::this_thread::sleep_for(100ms);
+  Check(runs.load() <= runs_at_cancel + 1, "periodic task stops");
+  pool.Stop();
+}
+
+// Stop discards pending timers without waiting for them
+void StopWithPendingTimers() {
+  twist::stdlike::atomic<size_t> ran{0};
+  {
+    tp::ThreadPool pool{2};
+    for (size_t i = 0; i < 100; ++i) {
+      pool.SubmitAfter(1h, [&] {
+        ran.fetch_add(1);
+      });
+    }
+    pool.SubmitEvery(1h, [&] {
+      ran.fetch_add(1);
+    });
+
+    auto start = tp::Clock::now();
+    pool.Stop();
+    Check(tp::Clock::now() - start < 1s, "Stop does not wait for timers");
+  }
+  Check(ran.load() == 0, "discarded timers do not run");
+}
+
+int main() {
+  WheelBoundaries();
+  WheelRandom();
+  WheelRemove();
+
+  SubmitAfter();
+  CancelBeforeFire();
+  SubmitEvery();
+  StopWithPendingTimers();
+
+  std::cout << "OK" << std::endl;
+  return 0;
+}
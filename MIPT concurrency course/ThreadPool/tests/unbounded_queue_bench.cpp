@@ -0,0 +1,91 @@
+#include <tp/blocking_queue.hpp>
+#include <tp/lock_free_queue.hpp>
+
+#include <twist/stdlike/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// UnboundedBlockingQueue vs LockFreeUnboundedQueue under equal
+// numbers of producers and consumers. Consumers run until the queue
+// is closed and drained
+
+// Every item is its own Put timestamp, so consumers measure
+// the latency from Put to Take
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kThreadCounts[] = {2, 4, 8, 16, 32, 64};
+static const size_t kItemsPerProducer = 50000;
+
+static uint64_t NowNanos() {
+  return Clock::now().time_since_epoch() / std::chrono::nanoseconds(1);
+}
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+template <typename Queue>
+void Run(const char* name, size_t threads) {
+  Queue queue;
+
+  const size_t pairs = threads / 2;
+  std::vector<std::vector<uint64_t>> latencies(pairs);
+
+  auto start = Clock::now();
+
+  std::vector<twist::stdlike::thread> consumers;
+  for (size_t i = 0; i < pairs; ++i) {
+    consumers.emplace_back([&, i] {
+      auto& local = latencies[i];
+      local.reserve(kItemsPerProducer);
+      while (auto put_at = queue.Take()) {
+        local.push_back(NowNanos() - *put_at);
+      }
+    });
+  }
+
+  std::vector<twist::stdlike::thread> producers;
+  for (size_t i = 0; i < pairs; ++i) {
+    producers.emplace_back([&] {
+      for (size_t j = 0; j < kItemsPerProducer; ++j) {
+        queue.Put(NowNanos());
+      }
+    });
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  queue.Close();
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<uint64_t> all;
+  for (auto& local : latencies) {
+    all.insert(all.end(), local.begin(), local.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  std::printf("%-22s threads=%-3zu items/s=%-11.0f put->take ns: p50=%-9lu "
+              "p99=%lu\n",
+              name, threads, all.size() / seconds, Percentile(all, 0.5),
+              Percentile(all, 0.99));
+}
+
+int main() {
+  for (size_t threads : kThreadCounts) {
+    Run<tp::UnboundedBlockingQueue<uint64_t>>("UnboundedBlockingQueue",
+                                              threads);
+    Run<tp::LockFreeUnboundedQueue<uint64_t>>("LockFreeUnboundedQueue",
+                                              threads);
+  }
+  return 0;
+}
@@ -1,6 +1,9 @@
 #include <tp/thread_pool.hpp>
 
+#include <tp/topology.hpp>
+
 #include <cassert>
+#include <span>
 
 #include <twist/util/thread_local.hpp>
 
@@ -9,11 +12,40 @@ namespace tp {
 ////////////////////////////////////////////////////////////////////////////////
 
 static twist::util::ThreadLocalPtr<ThreadPool> pool;
+static twist::util::ThreadLocalPtr<detail::Worker> worker;
+
+// Check shared queue first once in a while,
+// otherwise workers that keep spawning local tasks starve it
+static const size_t kSharedQueuePollInterval = 61;
+
+// Max number of tasks a worker grabs from shared queue at once,
+// the rest of the batch goes to its local deque and can be stolen
+static const size_t kSharedQueueBatchSize = 16;
+
+// PickPolicy::Weighted schedule: High, Normal, Low lanes get 4 : 2 : 1
+static const Priority kWeightedSchedule[] = {
+    Priority::High,   Priority::Normal, Priority::High, Priority::Low,
+    Priority::High,   Priority::Normal, Priority::High,
+};
+
+static UnboundedBlockingQueue<Task>& Lane(
+    std::array<UnboundedBlockingQueue<Task>, kPriorityLanes>& lanes,
+    Priority priority) {
+  return lanes[static_cast<size_t>(priority)];
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-ThreadPool::ThreadPool(size_t workers) {
-  LaunchWorkers(workers);
+ThreadPool::ThreadPool(size_t workers, PickPolicy policy, Placement placement)
+    : ThreadPool(WorkerLimits{workers, workers}, policy, placement) {
+}
+
+ThreadPool::ThreadPool(WorkerLimits limits, PickPolicy policy,
+                       Placement placement)
+    : limits_(limits), policy_(policy), placement_(placement) {
+  assert(limits_.min > 0 && limits_.min <= limits_.max);
+  PlaceWorkers();
+  LaunchWorkers();
 }
 
 ThreadPool::~ThreadPool() {
@@ -21,51 +53,521 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::Submit(Task task) {
-  executing_tasks_counter_.Inc();
-  task_queue_.Put(std::move(task));
+  outstanding_tasks_.Add();
+  task.SetSubmitTime(detail::NowNanos());
+  if (Current() == this) {
+    worker->metrics.LocalQueueDepth(worker->local_tasks.Push(std::move(task)));
+  } else {
+    Lane(lanes_, Priority::Normal).Put(std::move(task));
+  }
+  WakeWorkers(1);
+}
+
+void ThreadPool::Submit(Task task, Priority priority) {
+  if (priority == Priority::Normal) {
+    Submit(std::move(task));
+    return;
+  }
+
+  outstanding_tasks_.Add();
+  task.SetSubmitTime(detail::NowNanos());
+  Lane(lanes_, priority).Put(std::move(task));
+  WakeWorkers(1);
+}
+
+void ThreadPool::Submit(Task task, Priority priority, Deadline deadline) {
+  Submit(
+      [task = std::move(task), deadline]() mutable {
+        if (Clock::now() < deadline) {
+          task();
+        }
+      },
+      priority);
+}
+
+void ThreadPool::SubmitOn(size_t node, Task task) {
+  if (node_queues_.empty()) {
+    Submit(std::move(task));
+    return;
+  }
+
+  assert(node < node_queues_.size());
+  if (Current() == this && worker->node == node) {
+    Submit(std::move(task));  // Local deque is already on that node
+    return;
+  }
+
+  outstanding_tasks_.Add();
+  task.SetSubmitTime(detail::NowNanos());
+  node_queues_[node].Put(std::move(task));
+  WakeWorkers(1);
+}
+
+TimerHandle ThreadPool::SubmitAfter(Clock::duration delay, Task task) {
+  return timers_.Add(delay, Clock::duration::zero(), std::move(task));
+}
+
+TimerHandle ThreadPool::SubmitEvery(Clock::duration period, Task task) {
+  assert(period > Clock::duration::zero());
+  return timers_.Add(period, period, std::move(task));
+}
+
+void ThreadPool::SubmitBatch(std::vector<Task> tasks) {
+  const size_t count = tasks.size();
+  if (count == 0) {
+    return;
+  }
+
+  outstanding_tasks_.Add(count);
+  const uint64_t now = detail::NowNanos();
+  for (auto& task : tasks) {
+    task.SetSubmitTime(now);
+  }
+  if (Current() == this) {
+    worker->metrics.LocalQueueDepth(worker->local_tasks.PushBatch(tasks));
+  } else {
+    Lane(lanes_, Priority::Normal).PutBatch(tasks);
+  }
+  WakeWorkers(count);
 }
 
 void ThreadPool::WaitIdle() {
-  executing_tasks_counter_.Wait();
+  outstanding_tasks_.Wait();
 }
 
 void ThreadPool::Stop() {
-  task_queue_.Cancel();
-  for (auto& worker : worker_threads_) {
-    worker.join();
+  // Timer thread submits to the pool, stop it first
+  timers_.Stop();
+
+  stopped_.store(true);
+  for (auto& lane : lanes_) {
+    lane.Cancel();
+  }
+  for (auto& queue : node_queues_) {
+    queue.Cancel();
+  }
+
+  wakeups_.fetch_add(1);
+  wakeups_.FutexWakeAll();
+  {
+    std::lock_guard guard(idle_mutex_);
+    idle_.notify_all();
+  }
+
+  // No workers are spawned after stopped_ is set,
+  // retiring workers do not touch their thread objects
+  std::vector<twist::stdlike::thread> threads;
+  {
+    std::lock_guard guard(workers_mutex_);
+    threads = std::move(worker_threads_);
+    worker_threads_.clear();
+  }
+  for (auto& thread : threads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
   }
-  worker_threads_.clear();
+}
+
+size_t ThreadPool::Workers() const {
+  return live_workers_.load();
+}
+
+size_t ThreadPool::Nodes() const {
+  return node_workers_.size();
+}
+
+std::optional<size_t> ThreadPool::NodeIndex(size_t node_id) const {
+  if (node_ids_.empty()) {
+    return 0;  // Single node
+  }
+  for (size_t i = 0; i < node_ids_.size(); ++i) {
+    if (node_ids_[i] == node_id) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+PoolStats ThreadPool::Stats() const {
+  PoolStats stats;
+  stats.workers.reserve(workers_.size());
+  for (const auto& self : workers_) {
+    stats.workers.push_back(self.metrics.Snapshot());
+  }
+  return stats;
+}
+
+void ThreadPool::DumpTrace(std::ostream& out) const {
+  out << "{\"traceEvents\":[\n";
+#if defined(TP_ENABLE_TRACE)
+  bool first = true;
+  for (const auto& self : workers_) {
+    self.trace.Dump(out, self.index, first);
+  }
+#endif
+  out << "\n]}\n";
 }
 
 ThreadPool* ThreadPool::Current() {
   return pool;
 }
 
-void ThreadPool::LaunchWorkers(size_t workers) {
-  for (size_t i = 0; i < workers; ++i) {
-    worker_threads_.emplace_back([this] {
-      pool = this;
-      Work();
-    });
+void ThreadPool::PlaceWorkers() {
+  // Victims must be in place before anyone starts stealing
+  for (size_t i = 0; i < limits_.max; ++i) {
+    workers_.emplace_back(i);
+  }
+
+  if (!placement_.pin_workers && !placement_.numa_aware) {
+    node_workers_.emplace_back();
+    for (auto& self : workers_) {
+      node_workers_[0].push_back(self.index);
+    }
+    return;
+  }
+
+  auto topology = Topology::Detect();
+  if (placement_.numa_aware) {
+    node_ids_ = topology.node_ids;
+  } else {
+    topology.nodes = {topology.Cpus()};
+  }
+
+  // Interleave workers over nodes, so that any prefix of slots
+  // (an elastic pool runs the first min of them) is spread evenly
+  const size_t nodes = topology.nodes.size();
+  node_workers_.resize(nodes);
+  for (auto& self : workers_) {
+    self.node = self.index % nodes;
+    node_workers_[self.node].push_back(self.index);
+    const auto& cpus = topology.nodes[self.node];
+    if (placement_.pin_workers && !cpus.empty()) {
+      self.cpu = cpus[(self.index / nodes) % cpus.size()];
+    }
+  }
+
+  if (nodes > 1) {
+    for (size_t i = 0; i < nodes; ++i) {
+      node_queues_.emplace_back();
+    }
+  }
+}
+
+void ThreadPool::LaunchWorkers() {
+  worker_threads_.resize(limits_.max);
+  for (size_t i = limits_.max; i > limits_.min; --i) {
+    free_slots_.push_back(i - 1);
+  }
+
+  std::lock_guard guard(workers_mutex_);
+  live_workers_.store(limits_.min);
+  for (size_t i = 0; i < limits_.min; ++i) {
+    LaunchWorker(i);
+  }
+}
+
+void ThreadPool::LaunchWorker(size_t slot) {
+  auto& thread = worker_threads_[slot];
+  if (thread.joinable()) {
+    // Retired worker has already released the slot and is exiting
+    thread.join();
+  }
+
+  auto& self = workers_[slot];
+  self.active.store(true);
+  thread = twist::stdlike::thread([this, &self] {
+    if (self.cpu.has_value()) {
+      PinCurrentThread(*self.cpu);
+    }
+    pool = this;
+    worker = &self;
+    Work(self);
+    ReleaseSlot(self);
+  });
+}
+
+void ThreadPool::MaybeSpawnWorker() {
+  if (limits_.max == limits_.min) {
+    return;  // Fixed-size pool
+  }
+
+  // Tasks waiting for a worker: outstanding - (live - parked),
+  // spawn if they outnumber parked workers by spawn_backlog
+  const size_t live = live_workers_.load();
+  if (live >= limits_.max ||
+      outstanding_tasks_.Count() < live + limits_.spawn_backlog) {
+    return;
+  }
+
+  std::lock_guard guard(workers_mutex_);
+  // Workers are only spawned under workers_mutex_,
+  // so live_workers_ can only go down concurrently
+  if (stopped_.load() || free_slots_.empty() ||
+      live_workers_.load() >= limits_.max) {
+    return;
+  }
+  size_t slot = free_slots_.back();
+  free_slots_.pop_back();
+  live_workers_.fetch_add(1);
+  LaunchWorker(slot);
+}
+
+bool ThreadPool::TryRetire() {
+  size_t live = live_workers_.load();
+  while (live > limits_.min) {
+    if (live_workers_.compare_exchange_weak(live, live - 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::ReleaseSlot(detail::Worker& self) {
+  std::lock_guard guard(workers_mutex_);
+  self.active.store(false);
+  if (!stopped_.load()) {
+    free_slots_.push_back(self.index);
   }
 }
 
-void ThreadPool::Work() {
-  while (true) {
-    auto task = task_queue_.Take();
+void ThreadPool::Work(detail::Worker& self) {
+  while (auto task = PickTask(self)) {
+    const uint64_t started_at = detail::NowNanos();
+    TP_TRACE_EVENT(self, TaskStart, started_at);
+
+    detail::RunTask(*task);
+
+    const uint64_t finished_at = detail::NowNanos();
+    TP_TRACE_EVENT(self, TaskFinish, finished_at);
+    self.metrics.TaskCompleted(task->SubmitTime(), started_at, finished_at);
+
+    outstanding_tasks_.Done();
+  }
+
+  self.local_tasks.Clear();
+}
+
+std::optional<Task> ThreadPool::PickTask(detail::Worker& self) {
+  while (!stopped_.load()) {
+    if (auto task = TryPickTask(self)) {
+      return task;
+    }
+
+    uint32_t wakeups = wakeups_.load();
+    parked_workers_.fetch_add(1);
+
+    // Re-check after announcing ourselves, pairs with WakeWorkers
+    auto task = TryPickTask(self);
+    bool idle_expired = false;
+    if (!task.has_value() && !stopped_.load()) {
+      const uint64_t parked_at = detail::NowNanos();
+      TP_TRACE_EVENT(self, Park, parked_at);
+
+      if (live_workers_.load() > limits_.min) {
+        idle_expired = !ParkFor(wakeups);
+      } else {
+        wakeups_.FutexWait(wakeups);
+      }
+
+      const uint64_t unparked_at = detail::NowNanos();
+      TP_TRACE_EVENT(self, Unpark, unparked_at);
+      self.metrics.Parked(unparked_at - parked_at);
+    }
+
+    parked_workers_.fetch_sub(1);
 
     if (task.has_value()) {
-      try {
-        task.value()();
-      } catch (...) {
+      return task;
+    }
+
+    if (idle_expired) {
+      // Last look: submitters may have seen us as parked
+      if (auto task = TryPickTask(self)) {
+        return task;
+      }
+      if (TryRetire()) {
+        return std::nullopt;
       }
+    }
+  }
 
-      executing_tasks_counter_.Dec();
+  return std::nullopt;
+}
+
+bool ThreadPool::ParkFor(uint32_t wakeups) {
+  std::unique_lock lock(idle_mutex_);
+  // Pairs with WakeWorkers: either we see the new epoch
+  // or the waker sees us and notifies under idle_mutex_
+  idle_waiters_.fetch_add(1);
+  bool woken = idle_.wait_for(lock, limits_.idle_timeout, [&] {
+    return wakeups_.load() != wakeups;
+  });
+  idle_waiters_.fetch_sub(1);
+  return woken;
+}
+
+std::optional<Task> ThreadPool::TryPickTask(detail::Worker& self) {
+  ++self.ticks;
+
+  Priority preferred = Priority::High;
+  if (policy_ == PickPolicy::Weighted) {
+    preferred = kWeightedSchedule[self.ticks % std::size(kWeightedSchedule)];
+  }
+
+  if (auto task = TryPickFromLane(self, preferred)) {
+    return task;
+  }
+
+  // Preferred lane is empty, fall back to strict order
+  for (size_t lane = 0; lane < kPriorityLanes; ++lane) {
+    auto priority = static_cast<Priority>(lane);
+    if (priority == preferred) {
+      continue;
+    }
+    if (auto task = TryPickFromLane(self, priority)) {
+      return task;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<Task> ThreadPool::TryPickFromLane(detail::Worker& self,
+                                                Priority lane) {
+  if (lane == Priority::Normal) {
+    return TryPickNormal(self);
+  }
+
+  auto& queue = Lane(lanes_, lane);
+  if (queue.IsEmpty()) {
+    return std::nullopt;
+  }
+  return queue.TryTake();
+}
+
+std::optional<Task> ThreadPool::TryPickNormal(detail::Worker& self) {
+  if (self.ticks % kSharedQueuePollInterval == 0) {
+    if (!node_queues_.empty()) {
+      if (auto task = node_queues_[self.node].TryTake()) {
+        return task;
+      }
+    }
+    if (auto task = Lane(lanes_, Priority::Normal).TryTake()) {
+      return task;
+    }
+  }
+
+  if (auto task = self.local_tasks.TryPop()) {
+    return task;
+  }
+
+  if (!node_queues_.empty()) {
+    if (auto task = TryTakeShared(self, node_queues_[self.node])) {
+      return task;
+    }
+  }
+
+  if (auto task = TryTakeShared(self, Lane(lanes_, Priority::Normal))) {
+    return task;
+  }
+
+  return TrySteal(self);
+}
+
+std::optional<Task> ThreadPool::TryTakeShared(
+    detail::Worker& self, UnboundedBlockingQueue<Task>& queue) {
+  if (queue.IsEmpty()) {
+    return std::nullopt;
+  }
+
+  auto batch = queue.TryTakeBatch(kSharedQueueBatchSize);
+  if (batch.empty()) {
+    return std::nullopt;
+  }
+
+  // Run the oldest task right away, move the rest in place
+  if (batch.size() > 1) {
+    auto rest = std::span<Task>(batch).subspan(1);
+    self.metrics.LocalQueueDepth(self.local_tasks.PushBatch(rest));
+  }
+  return std::move(batch.front());
+}
+
+std::optional<Task> ThreadPool::TrySteal(detail::Worker& self) {
+  // Own node first, its tasks' data is likely in the local memory
+  auto task = TryStealFrom(self, self.node);
+
+  // Remote nodes: their SubmitOn queues, then their workers
+  const size_t nodes = node_workers_.size();
+  for (size_t i = 1; i < nodes && !task.has_value(); ++i) {
+    const size_t node = (self.node + i) % nodes;
+    if (!node_queues_.empty() && !node_queues_[node].IsEmpty()) {
+      task = node_queues_[node].TryTake();
+    }
+    if (!task.has_value()) {
+      task = TryStealFrom(self, node);
+    }
+  }
+
+  self.metrics.StealAttempt(/*success=*/task.has_value());
+  if (task.has_value()) {
+    TP_TRACE_EVENT(self, Steal, detail::NowNanos());
+  }
+  return task;
+}
+
+std::optional<Task> ThreadPool::TryStealFrom(detail::Worker& self,
+                                             size_t node) {
+  const auto& victims = node_workers_[node];
+  const size_t count = victims.size();
+  if (count == 0) {
+    return std::nullopt;
+  }
+  const size_t start = self.random() % count;
+
+  for (size_t i = 0; i < count; ++i) {
+    auto& victim = workers_[victims[(start + i) % count]];
+    if (&victim == &self || !victim.active.load()) {
+      continue;
+    }
+    if (auto task = victim.local_tasks.TrySteal()) {
+      return task;
+    }
+  }
+
+  return std::nullopt;
+}
+
+void ThreadPool::WakeWorkers(size_t count) {
+  // Parked workers are counted as free: backlog that exceeds them
+  // does not depend on whether they have woken up yet
+  MaybeSpawnWorker();
+
+  const size_t parked = parked_workers_.load();
+  if (parked == 0) {
+    return;
+  }
+
+  wakeups_.fetch_add(1);
+  if (count >= parked) {
+    wakeups_.FutexWakeAll();
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      wakeups_.FutexWakeOne();
+    }
+  }
+
+  if (idle_waiters_.load() > 0) {
+    std::lock_guard guard(idle_mutex_);
+    if (count >= parked) {
+      idle_.notify_all();
     } else {
-      break;
+      for (size_t i = 0; i < count; ++i) {
+        idle_.notify_one();
+      }
     }
   }
 }
 
 }  // namespace tp
-
@@ -1,21 +1,81 @@
 #pragma once
 
 #include <tp/blocking_queue.hpp>
-#include <tp/blocking_counter.hpp>
+#include <tp/metrics.hpp>
+#include <tp/placement.hpp>
+#include <tp/priority.hpp>
+#include <tp/wait_group.hpp>
+#include <tp/work_stealing_queue.hpp>
 #include <tp/task.hpp>
+#include <tp/timer_queue.hpp>
+#include <tp/trace.hpp>
+#include <tp/worker_limits.hpp>
 
+#include <array>
 #include <cstdint>
-#include <list>
-
+#include <deque>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/condition_variable.hpp>
+#include <twist/stdlike/mutex.hpp>
 #include <twist/stdlike/thread.hpp>
 
 namespace tp {
 
-// Fixed-size pool of worker threads
+namespace detail {
+
+struct Worker {
+  explicit Worker(size_t index) : index(index), random(index + 1) {
+  }
+
+  const size_t index;
+  WorkStealingQueue<Task> local_tasks;
+  std::minstd_rand random;  // Victim selection
+  size_t ticks{0};
+  // Placement, fixed before the thread starts
+  size_t node{0};
+  std::optional<size_t> cpu;
+  // Slot is occupied by a running thread
+  twist::stdlike::atomic<bool> active{false};
+
+  WorkerMetrics metrics;
+#if defined(TP_ENABLE_TRACE)
+  TraceBuffer trace;
+#endif
+};
+
+}  // namespace detail
+
+// Pool of worker threads
+
+// Work-stealing scheduler: tasks submitted from a worker thread go
+// to its local deque, tasks submitted from outside go to the shared queue.
+// Idle workers steal from random victims before they park
+
+// High and Low priority tasks bypass local deques and go to their own
+// shared lanes, PickPolicy decides how workers choose between lanes
+
+// Elastic pool keeps between limits.min and limits.max workers:
+// Submit spawns a worker when queued tasks outnumber parked workers,
+// surplus workers retire after an idle timeout
+
+// Placement pins workers to cores and/or groups them by NUMA node:
+// each node gets its own queue and thieves look at their own node first
 
 class ThreadPool {
  public:
-  explicit ThreadPool(size_t workers);
+  // Fixed-size pool
+  explicit ThreadPool(size_t workers,
+                      PickPolicy policy = PickPolicy::Strict,
+                      Placement placement = {});
+
+  explicit ThreadPool(WorkerLimits limits,
+                      PickPolicy policy = PickPolicy::Strict,
+                      Placement placement = {});
   ~ThreadPool();
 
   // Non-copyable
@@ -25,26 +85,118 @@ class ThreadPool {
   // Schedules task for execution in one of the worker threads
   void Submit(Task task);
 
+  void Submit(Task task, Priority priority);
+
+  // Task is dropped if it has not started by the deadline
+  void Submit(Task task, Priority priority, Deadline deadline);
+
+  // Placement hint: task runs on a worker of the given NUMA node
+  // unless they are all busy and remote workers steal it
+  // node is a compact index in [0, Nodes()), not an OS node id,
+  // see NodeIndex. Same as Submit(task) if the pool is not NUMA-aware
+  void SubmitOn(size_t node, Task task);
+
+  // Runs task on a worker after delay
+  // Pending timers do not count as outstanding work for WaitIdle
+  TimerHandle SubmitAfter(Clock::duration delay, Task task);
+
+  // Runs task every period until cancelled or the pool is stopped
+  // Next run is scheduled when the previous one has finished
+  TimerHandle SubmitEvery(Clock::duration period, Task task);
+
+  // Schedules a burst of tasks with a single counter update
+  // and a single queue lock acquisition
+  void SubmitBatch(std::vector<Task> tasks);
+
   // Waits until outstanding work count has reached zero
   void WaitIdle();
 
   // Stops the worker threads as soon as possible
-  // Pending tasks will be discarded
+  // Pending tasks and timers will be discarded
   void Stop();
 
+  // Number of running worker threads, may be stale
+  size_t Workers() const;
+
+  // Number of NUMA nodes workers are grouped by
+  size_t Nodes() const;
+
+  // Maps OS NUMA node id to the compact index SubmitOn takes,
+  // nullopt if the pool has no workers there.
+  // Every id maps to 0 if the pool is not NUMA-aware
+  std::optional<size_t> NodeIndex(size_t node_id) const;
+
+  // Per-worker counters and latency histograms,
+  // safe to call at any time from any thread
+  // Zeros unless compiled with TP_ENABLE_METRICS
+  PoolStats Stats() const;
+
+  // Writes recent scheduling events in Chrome trace JSON format
+  // Empty unless compiled with TP_ENABLE_TRACE
+  void DumpTrace(std::ostream& out) const;
+
   // Locates current thread pool from worker thread
   static ThreadPool* Current();
 
  private:
-  void LaunchWorkers(size_t workers);
-  void Work();
+  void PlaceWorkers();
+  void LaunchWorkers();
+  // Guarded by workers_mutex_
+  void LaunchWorker(size_t slot);
+  void Work(detail::Worker& self);
+  void MaybeSpawnWorker();
+  bool TryRetire();
+  void ReleaseSlot(detail::Worker& self);
+
+  std::optional<Task> PickTask(detail::Worker& self);
+  // Returns false on timeout
+  bool ParkFor(uint32_t wakeups);
+  std::optional<Task> TryPickTask(detail::Worker& self);
+  std::optional<Task> TryPickFromLane(detail::Worker& self, Priority lane);
+  std::optional<Task> TryPickNormal(detail::Worker& self);
+  std::optional<Task> TryTakeShared(detail::Worker& self,
+                                    UnboundedBlockingQueue<Task>& queue);
+  std::optional<Task> TrySteal(detail::Worker& self);
+  std::optional<Task> TryStealFrom(detail::Worker& self, size_t node);
+
+  void WakeWorkers(size_t count);
 
  private:
-  UnboundedBlockingQueue<Task> task_queue_;
-  std::list<twist::stdlike::thread> worker_threads_;
-  detail::BlockingZeroWaitMPMCCounter executing_tasks_counter_;
-
-  // Worker threads, task queue, etc
+  const WorkerLimits limits_;
+  const PickPolicy policy_;
+  const Placement placement_;
+  // Shared queues, one per priority
+  std::array<UnboundedBlockingQueue<Task>, kPriorityLanes> lanes_;
+  // limits_.max slots, allocated once so that stealers
+  // can walk them without synchronization
+  std::deque<detail::Worker> workers_;
+  detail::WaitGroup outstanding_tasks_;
+
+  // NUMA
+  // Worker slots of each node, a single node unless NUMA-aware
+  std::vector<std::vector<size_t>> node_workers_;
+  // OS node id of each node, empty unless NUMA-aware
+  std::vector<size_t> node_ids_;
+  // SubmitOn queues, empty unless NUMA-aware with several nodes
+  std::deque<UnboundedBlockingQueue<Task>> node_queues_;
+
+  detail::TimerQueue timers_{*this};
+
+  // Elasticity
+  twist::stdlike::mutex workers_mutex_;
+  // guarded by workers_mutex_
+  std::vector<twist::stdlike::thread> worker_threads_;
+  std::vector<size_t> free_slots_;
+  twist::stdlike::atomic<size_t> live_workers_{0};
+
+  // Parking
+  twist::stdlike::atomic<uint32_t> wakeups_{0};
+  twist::stdlike::atomic<uint32_t> parked_workers_{0};
+  twist::stdlike::atomic<bool> stopped_{false};
+  // Timed parking for workers that may retire
+  twist::stdlike::mutex idle_mutex_;
+  twist::stdlike::condition_variable idle_;
+  twist::stdlike::atomic<uint32_t> idle_waiters_{0};
 };
 
 inline ThreadPool* Current() {
@@ -52,4 +204,3 @@ inline ThreadPool* Current() {
 }
 
 }  // namespace tp
-
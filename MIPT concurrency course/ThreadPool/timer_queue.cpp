@@ -0,0 +1,207 @@
+#include <tp/timer_queue.hpp>
+
+#include <tp/thread_pool.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace tp {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Keeps time arithmetic far from overflow
+static const Clock::duration kMaxDelay = std::chrono::hours(24 * 365 * 100);
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TimerHandle::Cancel() {
+  if (auto node = node_.lock()) {
+    return queue_->Cancel(node);
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+TimerQueue::TimerQueue(ThreadPool& pool)
+    : pool_(pool), origin_(Clock::now()) {
+}
+
+TimerQueue::~TimerQueue() {
+  assert(!thread_.joinable());
+}
+
+TimerHandle TimerQueue::Add(Clock::duration delay, Clock::duration period,
+                            Task task) {
+  auto node = std::make_shared<TimerNode>();
+  node->task = std::move(task);
+  node->period = period;
+
+  {
+    std::lock_guard guard(mutex_);
+
+    if (stopped_) {
+      return {};
+    }
+    if (!started_) {
+      started_ = true;
+      thread_ = twist::stdlike::thread([this] {
+        Loop();
+      });
+    }
+
+    if (ScheduleLocked(node, delay)) {
+      return {this, node};
+    }
+    node->state = period == Clock::duration::zero() ? TimerNode::State::Fired
+                                                    : TimerNode::State::Running;
+  }
+
+  // Already due
+  TimerHandle handle{this, node};
+  Fire(std::move(node));
+  return handle;
+}
+
+bool TimerQueue::Cancel(const std::shared_ptr<TimerNode>& node) {
+  std::lock_guard guard(mutex_);
+
+  switch (node->state) {
+    case TimerNode::State::Pending:
+      wheel_.Remove(node.get());
+      node->self.reset();  // Caller still holds a reference
+      node->state = TimerNode::State::Cancelled;
+      return true;
+    case TimerNode::State::Running:
+      node->state = TimerNode::State::Cancelled;  // Do not rearm
+      return true;
+    default:
+      return false;
+  }
+}
+
+void TimerQueue::Stop() {
+  std::vector<TimerLink*> pending;
+  std::vector<std::shared_ptr<TimerNode>> dropped;
+  {
+    std::lock_guard guard(mutex_);
+    stopped_ = true;
+    wheel_.Drain(pending);
+    for (TimerLink* link : pending) {
+      auto* node = static_cast<TimerNode*>(link);
+      node->state = TimerNode::State::Cancelled;
+      dropped.push_back(std::move(node->self));
+    }
+    wake_.notify_one();
+  }
+  // Tasks are destroyed outside of the lock
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void TimerQueue::Loop() {
+  std::vector<TimerLink*> expired;
+  std::vector<std::shared_ptr<TimerNode>> due;
+
+  std::unique_lock lock(mutex_);
+
+  while (!stopped_) {
+    wheel_.Advance(CurrentTick(), expired);
+
+    if (!expired.empty()) {
+      for (TimerLink* link : expired) {
+        auto* node = static_cast<TimerNode*>(link);
+        node->state = node->period == Clock::duration::zero()
+                          ? TimerNode::State::Fired
+                          : TimerNode::State::Running;
+        due.push_back(std::move(node->self));
+      }
+      expired.clear();
+
+      lock.unlock();
+      for (auto& node : due) {
+        Fire(std::move(node));
+      }
+      due.clear();
+      lock.lock();
+      continue;
+    }
+
+    // Sleep until the next expiration or cascade
+    wake_at_ = wheel_.NextEvent();
+    sleeping_ = true;
+    if (wake_at_.has_value()) {
+      wake_.wait_until(lock, origin_ + Tick(*wake_at_));
+    } else {
+      wake_.wait(lock);
+    }
+    sleeping_ = false;
+  }
+}
+
+void TimerQueue::Fire(std::shared_ptr<TimerNode> node) {
+  if (node->period == Clock::duration::zero()) {
+    pool_.Submit(std::move(node->task));
+    return;
+  }
+
+  // Fixed delay: next run is scheduled when this one has finished,
+  // so runs of the same periodic task never overlap
+  pool_.Submit([this, node = std::move(node)]() mutable {
+    try {
+      node->task();
+    } catch (...) {
+    }
+    Rearm(std::move(node));
+  });
+}
+
+void TimerQueue::Rearm(std::shared_ptr<TimerNode> node) {
+  {
+    std::lock_guard guard(mutex_);
+
+    if (stopped_ || node->state == TimerNode::State::Cancelled) {
+      return;
+    }
+    if (ScheduleLocked(node, node->period)) {
+      return;
+    }
+  }
+
+  Fire(std::move(node));
+}
+
+bool TimerQueue::ScheduleLocked(const std::shared_ptr<TimerNode>& node,
+                                Clock::duration delay) {
+  node->expires = ExpirationTick(delay);
+  if (!wheel_.Insert(node.get())) {
+    return false;
+  }
+  node->state = TimerNode::State::Pending;
+  node->self = node;
+
+  // Wake the timer thread only if it sleeps past the new expiration
+  if (sleeping_ && (!wake_at_.has_value() || node->expires < *wake_at_)) {
+    wake_at_ = node->expires;
+    wake_.notify_one();
+  }
+  return true;
+}
+
+uint64_t TimerQueue::ExpirationTick(Clock::duration delay) const {
+  delay = std::clamp(delay, Clock::duration::zero(), kMaxDelay);
+  // Round up: timer never fires early
+  return std::chrono::ceil<Tick>(Clock::now() + delay - origin_).count();
+}
+
+uint64_t TimerQueue::CurrentTick() const {
+  return std::chrono::floor<Tick>(Clock::now() - origin_).count();
+}
+
+}  // namespace detail
+
+}  // namespace tp
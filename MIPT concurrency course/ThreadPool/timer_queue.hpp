@@ -0,0 +1,124 @@
+#pragma once
+
+#include <tp/priority.hpp>
+#include <tp/task.hpp>
+#include <tp/timer_wheel.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <twist/stdlike/condition_variable.hpp>
+#include <twist/stdlike/mutex.hpp>
+#include <twist/stdlike/thread.hpp>
+
+namespace tp {
+
+class ThreadPool;
+
+namespace detail {
+
+class TimerQueue;
+
+struct TimerNode : TimerLink {
+  enum class State {
+    Pending,    // In the wheel
+    Running,    // Periodic task is on the pool
+    Fired,      // One-shot task is on the pool
+    Cancelled,
+  };
+
+  Task task;
+  Clock::duration period{0};  // Zero for one-shot timers
+  State state{State::Pending};
+  // Keeps the node alive while it is in the wheel
+  std::shared_ptr<TimerNode> self;
+};
+
+}  // namespace detail
+
+// Cancellation handle of a delayed or periodic task,
+// does not keep the task alive
+
+class TimerHandle {
+  friend class detail::TimerQueue;
+
+ public:
+  TimerHandle() = default;
+
+  // Returns true if the task will not run (again)
+  // Running task is not interrupted
+  // Must not be called after the pool is destroyed
+  bool Cancel();
+
+ private:
+  TimerHandle(detail::TimerQueue* queue,
+              std::weak_ptr<detail::TimerNode> node)
+      : queue_(queue), node_(std::move(node)) {
+  }
+
+ private:
+  detail::TimerQueue* queue_{nullptr};
+  std::weak_ptr<detail::TimerNode> node_;
+};
+
+namespace detail {
+
+// Delayed tasks of a ThreadPool, serviced by a single timer thread
+// that is started on first use
+
+// The thread sleeps until the next wheel event and hands due tasks
+// over to the pool, it never runs user code itself
+
+class TimerQueue {
+ public:
+  // Wheel resolution
+  using Tick = std::chrono::milliseconds;
+
+  explicit TimerQueue(ThreadPool& pool);
+  ~TimerQueue();
+
+  // Non-copyable
+  TimerQueue(const TimerQueue&) = delete;
+  TimerQueue& operator=(const TimerQueue&) = delete;
+
+  // period is zero for one-shot timers
+  TimerHandle Add(Clock::duration delay, Clock::duration period, Task task);
+
+  bool Cancel(const std::shared_ptr<TimerNode>& node);
+
+  // Drops pending timers and joins the timer thread
+  void Stop();
+
+ private:
+  void Loop();
+  void Fire(std::shared_ptr<TimerNode> node);
+  void Rearm(std::shared_ptr<TimerNode> node);
+
+  // Returns false if node is already due
+  bool ScheduleLocked(const std::shared_ptr<TimerNode>& node,
+                      Clock::duration delay);
+
+  uint64_t ExpirationTick(Clock::duration delay) const;
+  uint64_t CurrentTick() const;
+
+ private:
+  ThreadPool& pool_;
+  const Clock::time_point origin_;
+
+  TimerWheel wheel_;  // guarded by mutex_
+  bool started_{false};  // guarded by mutex_
+  bool stopped_{false};  // guarded by mutex_
+  // Timer thread is asleep until this tick, nullopt if awake
+  // or sleeping without a deadline, guarded by mutex_
+  std::optional<uint64_t> wake_at_;
+  bool sleeping_{false};  // guarded by mutex_
+
+  twist::stdlike::thread thread_;
+  twist::stdlike::mutex mutex_;
+  twist::stdlike::condition_variable wake_;
+};
+
+}  // namespace detail
+
+}  // namespace tp
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace tp::detail {
+
+// Intrusive link of a pending timer
+struct TimerLink {
+  TimerLink* prev{nullptr};
+  TimerLink* next{nullptr};
+  uint64_t expires{0};  // Tick
+  // Position in the wheel, valid while linked
+  size_t level{0};
+  size_t slot{0};
+  bool linked{false};
+};
+
+// Hierarchical timer wheel (G. Varghese, T. Lauck)
+
+// kLevels wheels of kSlots slots each, a slot on level L spans
+// kSlots^L ticks. Timer goes to the highest level where its expiration
+// tick differs from the current one, and cascades down level by level
+// as time approaches it. Timers beyond the top wheel wait in an overflow
+// list that is revisited once per top wheel rotation.
+// Insert and Remove are O(1), memory is a fixed array of slot heads
+// plus one link per timer
+
+// Occupancy bitmaps let Advance jump over empty slots,
+// so a long idle period costs O(levels), not O(ticks)
+
+// Not thread-safe
+
+class TimerWheel {
+  static const size_t kLevelBits = 6;
+  static const size_t kSlots = size_t{1} << kLevelBits;
+  static const size_t kLevels = 6;
+  // Pseudo-level with a single slot
+  static const size_t kOverflow = kLevels;
+
+ public:
+  // Non-copyable
+  TimerWheel() = default;
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  uint64_t Now() const {
+    return now_;
+  }
+
+  bool IsEmpty() const {
+    return size_ == 0;
+  }
+
+  // Returns false if timer is already due and has not been linked
+  bool Insert(TimerLink* timer) {
+    assert(!timer->linked);
+    if (timer->expires <= now_) {
+      return false;
+    }
+
+    const size_t level = LevelOf(timer->expires);
+    const size_t slot = SlotOf(timer->expires, level);
+    timer->level = level;
+    timer->slot = slot;
+    timer->linked = true;
+
+    TimerLink*& head = slots_[level][slot];
+    timer->prev = nullptr;
+    timer->next = head;
+    if (head != nullptr) {
+      head->prev = timer;
+    }
+    head = timer;
+    occupied_[level] |= uint64_t{1} << slot;
+    ++size_;
+    return true;
+  }
+
+  void Remove(TimerLink* timer) {
+    assert(timer->linked);
+    TimerLink*& head = slots_[timer->level][timer->slot];
+    if (timer->prev != nullptr) {
+      timer->prev->next = timer->next;
+    } else {
+      head = timer->next;
+    }
+    if (timer->next != nullptr) {
+      timer->next->prev = timer->prev;
+    }
+    if (head == nullptr) {
+      occupied_[timer->level] &= ~(uint64_t{1} << timer->slot);
+    }
+    timer->prev = timer->next = nullptr;
+    timer->linked = false;
+    --size_;
+  }
+
+  // Tick at which something (expiration or cascade) happens next
+  std::optional<uint64_t> NextEvent() const {
+    for (size_t level = 0; level < kLevels; ++level) {
+      // Timers are always ahead of the current slot
+      const size_t current = SlotOf(now_, level);
+      const uint64_t ahead =
+          current + 1 < kSlots
+              ? occupied_[level] & (~uint64_t{0} << (current + 1))
+              : 0;
+      if (ahead != 0) {
+        const size_t slot = std::countr_zero(ahead);
+        return RoundDown(now_, level + 1) +
+               (uint64_t{slot} << (kLevelBits * level));
+      }
+    }
+    if (occupied_[kOverflow] != 0) {
+      // Start of the next top wheel rotation
+      return RoundDown(now_, kLevels) + (uint64_t{1} << kTotalBits);
+    }
+    return std::nullopt;
+  }
+
+  // Moves time forward to tick, appends expired timers to expired
+  void Advance(uint64_t tick, std::vector<TimerLink*>& expired) {
+    while (now_ < tick) {
+      auto next = NextEvent();
+      if (!next.has_value() || *next > tick) {
+        now_ = tick;
+        return;
+      }
+      now_ = *next;
+
+      // Cascade slots we have just entered, from the top down
+      for (size_t level = kOverflow; level > 0; --level) {
+        if (RoundDown(now_, level) == now_) {
+          Cascade(level, SlotOf(now_, level), expired);
+        }
+      }
+
+      TakeAll(0, SlotOf(now_, 0), expired);
+    }
+  }
+
+  // Unlinks every pending timer
+  void Drain(std::vector<TimerLink*>& out) {
+    for (size_t level = 0; level <= kOverflow; ++level) {
+      for (size_t slot = 0; slot < kSlots; ++slot) {
+        TakeAll(level, slot, out);
+      }
+    }
+  }
+
+ private:
+  static const size_t kTotalBits = kLevelBits * kLevels;
+
+  size_t LevelOf(uint64_t expires) const {
+    // Highest group of kLevelBits bits where expires differs from now
+    const size_t diff_bits = std::bit_width(expires ^ now_);
+    // Copy of kOverflow: std::min takes its arguments by reference
+    return std::min((diff_bits - 1) / kLevelBits, size_t{kOverflow});
+  }
+
+  static size_t SlotOf(uint64_t tick, size_t level) {
+    if (level == kOverflow) {
+      return 0;
+    }
+    return (tick >> (kLevelBits * level)) & (kSlots - 1);
+  }
+
+  // Start of the level-sized span containing tick
+  static uint64_t RoundDown(uint64_t tick, size_t level) {
+    const size_t bits = kLevelBits * level;
+    return bits < 64 ? tick >> bits << bits : 0;
+  }
+
+  // Re-inserts timers of a slot we have just entered,
+  // they land on lower levels or expire
+  void Cascade(size_t level, size_t slot, std::vector<TimerLink*>& expired) {
+    TimerLink* timer = std::exchange(slots_[level][slot], nullptr);
+    occupied_[level] &= ~(uint64_t{1} << slot);
+    while (timer != nullptr) {
+      TimerLink* next = timer->next;
+      timer->linked = false;
+      --size_;
+      if (!Insert(timer)) {
+        expired.push_back(timer);
+      }
+      timer = next;
+    }
+  }
+
+  void TakeAll(size_t level, size_t slot, std::vector<TimerLink*>& out) {
+    while (TimerLink* timer = slots_[level][slot]) {
+      Remove(timer);
+      out.push_back(timer);
+    }
+  }
+
+ private:
+  uint64_t now_{0};
+  size_t size_{0};
+  TimerLink* slots_[kLevels + 1][kSlots] = {};
+  uint64_t occupied_[kLevels + 1] = {};
+};
+
+}  // namespace tp::detail
@@ -0,0 +1,142 @@
+#include <tp/topology.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#include <sched.h>
+#include <unistd.h>
+
+namespace tp {
+
+////////////////////////////////////////////////////////////////////////////////
+
+static const char* kNodesPath = "/sys/devices/system/node";
+static const std::string kNodePrefix = "node";
+
+// OS ids of nodeN entries, ascending. Ids need not be contiguous
+static std::vector<size_t> ListNodeIds() {
+  std::vector<size_t> ids;
+
+  std::error_code error;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(kNodesPath, error)) {
+    const std::string name = entry.path().filename().string();
+    if (name.size() <= kNodePrefix.size() ||
+        name.compare(0, kNodePrefix.size(), kNodePrefix) != 0) {
+      continue;
+    }
+    const std::string id = name.substr(kNodePrefix.size());
+    // isdigit is undefined for negative chars
+    auto is_digit = [](unsigned char c) {
+      return std::isdigit(c) != 0;
+    };
+    if (!std::all_of(id.begin(), id.end(), is_digit)) {
+      continue;  // e.g. "node_states"
+    }
+    ids.push_back(std::stoul(id));
+  }
+
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// Parses cpulist format: "0-3,8,10-11"
+static std::vector<size_t> ParseCpuList(const std::string& list) {
+  std::vector<size_t> cpus;
+
+  std::istringstream input(list);
+  std::string range;
+  while (std::getline(input, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    size_t dash = range.find('-');
+    size_t first = std::stoul(range.substr(0, dash));
+    size_t last =
+        dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+    for (size_t cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+
+  return cpus;
+}
+
+static std::vector<size_t> AllowedCpus(const std::vector<size_t>& cpus,
+                                       const cpu_set_t& allowed) {
+  std::vector<size_t> result;
+  for (size_t cpu : cpus) {
+    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Topology Topology::Detect() {
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    for (long cpu = 0; cpu < online && cpu < CPU_SETSIZE; ++cpu) {
+      CPU_SET(cpu, &allowed);
+    }
+  }
+
+  Topology topology;
+  for (size_t id : ListNodeIds()) {
+    std::ifstream file(std::string(kNodesPath) + "/" + kNodePrefix +
+                       std::to_string(id) + "/cpulist");
+    if (!file) {
+      continue;
+    }
+    std::string list;
+    std::getline(file, list);
+
+    auto cpus = AllowedCpus(ParseCpuList(list), allowed);
+    if (!cpus.empty()) {
+      topology.nodes.push_back(std::move(cpus));
+      topology.node_ids.push_back(id);
+    }
+  }
+
+  if (topology.nodes.empty()) {
+    std::vector<size_t> cpus;
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed)) {
+        cpus.push_back(cpu);
+      }
+    }
+    topology.nodes.push_back(std::move(cpus));
+    topology.node_ids.push_back(0);
+  }
+
+  return topology;
+}
+
+std::vector<size_t> Topology::Cpus() const {
+  std::vector<size_t> cpus;
+  for (const auto& node : nodes) {
+    cpus.insert(cpus.end(), node.begin(), node.end());
+  }
+  return cpus;
+}
+
+bool PinCurrentThread(size_t cpu) {
+  if (cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+}  // namespace tp
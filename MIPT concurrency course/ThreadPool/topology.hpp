@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace tp {
+
+// CPUs available to this process grouped by NUMA node
+
+// Nodes are numbered by compact index 0..nodes.size()-1,
+// OS node ids may be sparse (e.g. 0 and 2 only)
+
+struct Topology {
+  std::vector<std::vector<size_t>> nodes;
+  // OS node id of nodes[i], ascending
+  std::vector<size_t> node_ids;
+
+  // Reads /sys/devices/system/node, falls back to
+  // a single node when NUMA information is unavailable
+  static Topology Detect();
+
+  // All CPUs in node order
+  std::vector<size_t> Cpus() const;
+};
+
+// Restricts the calling thread to a single CPU,
+// returns false if the platform refuses
+bool PinCurrentThread(size_t cpu);
+
+}  // namespace tp
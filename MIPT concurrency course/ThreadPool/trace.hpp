@@ -0,0 +1,102 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Define TP_ENABLE_TRACE to record per-worker scheduling events,
+// ThreadPool::DumpTrace writes them in Chrome trace format
+// (chrome://tracing, ui.perfetto.dev)
+
+namespace tp::detail {
+
+enum class TraceEventType : uint8_t {
+  TaskStart,
+  TaskFinish,
+  Park,
+  Unpark,
+  Steal,
+};
+
+// Fixed-size ring of the most recent events of a single worker
+
+// Event is packed into one word: timestamp in nanoseconds << 3 | type.
+// Only the owner writes, so recording is two plain stores,
+// no read-modify-write and no allocation.
+// Concurrent Dump sees a best-effort snapshot
+
+class TraceBuffer {
+  static const size_t kTypeBits = 3;
+
+ public:
+  static const size_t kCapacity = 1 << 14;
+
+  void Record(TraceEventType type, uint64_t timestamp) {
+    const size_t next = next_.load(std::memory_order_relaxed);
+    events_[next % kCapacity].store(
+        timestamp << kTypeBits | static_cast<uint64_t>(type),
+        std::memory_order_relaxed);
+    next_.store(next + 1, std::memory_order_release);
+  }
+
+  // Writes events as comma-separated Chrome trace JSON objects,
+  // first is cleared once something has been written
+  void Dump(std::ostream& out, size_t tid, bool& first) const {
+    const size_t end = next_.load(std::memory_order_acquire);
+    const size_t begin = end > kCapacity ? end - kCapacity : 0;
+
+    for (size_t i = begin; i < end; ++i) {
+      const uint64_t event =
+          events_[i % kCapacity].load(std::memory_order_relaxed);
+      const uint64_t timestamp = event >> kTypeBits;
+      const auto type = static_cast<TraceEventType>(
+          event & ((uint64_t{1} << kTypeBits) - 1));
+
+      const char* name = "task";
+      const char* phase = "B";
+      switch (type) {
+        case TraceEventType::TaskStart:
+          break;
+        case TraceEventType::TaskFinish:
+          phase = "E";
+          break;
+        case TraceEventType::Park:
+          name = "parked";
+          break;
+        case TraceEventType::Unpark:
+          name = "parked";
+          phase = "E";
+          break;
+        case TraceEventType::Steal:
+          name = "steal";
+          phase = "i";
+          break;
+      }
+
+      if (!first) {
+        out << ",\n";
+      }
+      first = false;
+
+      out << "{\"name\":\"" << name << "\",\"ph\":\"" << phase
+          << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":"
+          << timestamp / 1000 << "." << timestamp % 1000 / 100
+          << "}";
+    }
+  }
+
+ private:
+  twist::stdlike::atomic<uint64_t> events_[kCapacity];
+  twist::stdlike::atomic<size_t> next_{0};
+};
+
+}  // namespace tp::detail
+
+#if defined(TP_ENABLE_TRACE)
+#define TP_TRACE_EVENT(worker, type, timestamp) \
+  (worker).trace.Record(::tp::detail::TraceEventType::type, timestamp)
+#else
+#define TP_TRACE_EVENT(worker, type, timestamp) ((void)0)
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <cstdint>
+
+namespace tp::detail {
+
+// Counts outstanding work, Wait blocks until counter reaches zero
+
+// Add/Done are a single atomic RMW when nobody waits,
+// waiters park on a futex only when they really have to block
+
+class WaitGroup {
+ public:
+  void Add(size_t count = 1) {
+    counter_.fetch_add(count);
+  }
+
+  void Done() {
+    if (counter_.fetch_sub(1) == 1 && waiters_.load() > 0) {
+      zero_reached_.fetch_add(1);
+      zero_reached_.FutexWakeAll();
+    }
+  }
+
+  void Wait() {
+    while (counter_.load() > 0) {
+      uint32_t epoch = zero_reached_.load();
+      waiters_.fetch_add(1);
+      // Re-check after announcing ourselves, pairs with Done
+      if (counter_.load() > 0) {
+        zero_reached_.FutexWait(epoch);
+      }
+      waiters_.fetch_sub(1);
+    }
+  }
+
+  // Snapshot of outstanding work, may be stale
+  size_t Count() const {
+    return counter_.load();
+  }
+
+ private:
+  twist::stdlike::atomic<size_t> counter_{0};
+  twist::stdlike::atomic<uint32_t> waiters_{0};
+  twist::stdlike::atomic<uint32_t> zero_reached_{0};
+};
+
+}  // namespace tp::detail
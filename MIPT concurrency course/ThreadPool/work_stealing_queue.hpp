@@ -0,0 +1,71 @@
+#pragma once
+
+#include <twist/stdlike/mutex.hpp>
+
+#include <optional>
+#include <deque>
+
+namespace tp::detail {
+
+// Per-worker task deque
+
+// The owner pushes and pops at the back (LIFO, cache-friendly),
+// thieves steal from the front (oldest tasks first).
+// Mutex is almost always uncontended: only the owner and
+// an occasional thief touch the same deque
+
+template <typename T>
+class WorkStealingQueue {
+ public:
+  // Returns queue size after the push
+  size_t Push(T value) {
+    std::lock_guard guard(mutex_);
+    buffer_.push_back(std::move(value));
+    return buffer_.size();
+  }
+
+  // Pushes all values from range under a single lock acquisition
+  template <typename Range>
+  size_t PushBatch(Range&& values) {
+    std::lock_guard guard(mutex_);
+    for (auto& value : values) {
+      buffer_.push_back(std::move(value));
+    }
+    return buffer_.size();
+  }
+
+  std::optional<T> TryPop() {
+    std::lock_guard guard(mutex_);
+
+    if (buffer_.empty()) {
+      return std::nullopt;
+    }
+
+    T value = std::move(buffer_.back());
+    buffer_.pop_back();
+    return value;
+  }
+
+  std::optional<T> TrySteal() {
+    std::lock_guard guard(mutex_);
+
+    if (buffer_.empty()) {
+      return std::nullopt;
+    }
+
+    T value = std::move(buffer_.front());
+    buffer_.pop_front();
+    return value;
+  }
+
+  void Clear() {
+    std::lock_guard guard(mutex_);
+    buffer_.clear();
+  }
+
+ private:
+  std::deque<T> buffer_;  //  guarded by mutex_
+  twist::stdlike::mutex mutex_;
+};
+
+}  // namespace tp::detail
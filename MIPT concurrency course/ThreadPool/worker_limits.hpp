@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace tp {
+
+// Bounds for an elastic pool: it starts with min workers
+// and grows up to max under load
+
+struct WorkerLimits {
+  size_t min;
+  size_t max;
+
+  // A worker is spawned when tasks waiting for a worker
+  // outnumber parked workers by at least this much
+  size_t spawn_backlog = 1;
+
+  // Workers above min retire after being parked this long
+  std::chrono::milliseconds idle_timeout{1000};
+};
+
+}  // namespace tp